@@ -27,11 +27,20 @@
 
 #include <evtsigslot/slot_state.h>
 
+#include <cstdint>
 #include <cstdio>
 #include <memory>
 
 namespace evtsigslot {
 
+namespace detail {
+class SlotTable;
+}
+
+namespace trace {
+class Tracer;
+}
+
 class BindingBlocker {
  public:
   BindingBlocker() = default;
@@ -100,8 +109,11 @@ class Binding {
   BindingBlocker Blocker() noexcept { return BindingBlocker(state_); }
 
  protected:
-  template <typename>
+  template <typename, typename>
   friend class Signal;
+  template <typename, typename>
+  friend class RoutedSignal;
+  friend class trace::Tracer;
   explicit Binding(std::weak_ptr<detail::SlotState> s) noexcept
       : state_(std::move(s)) {}
 
@@ -127,13 +139,44 @@ class ScopedBinding : public Binding {
   }
 
  private:
-  template <typename>
+  template <typename, typename>
   friend class Signal;
 
   explicit ScopedBinding(std::weak_ptr<detail::SlotState> s) noexcept
       : Binding(std::move(s)) {}
 };
 
+/**
+ * @brief: Compact handle of slot binded with Signal::BindId, index and
+ * generation into the slot table of that signal. It is used through the
+ * signal that returned it and doesn't keep anything alive.
+ */
+class BindingId {
+ public:
+  BindingId() = default;
+
+  bool Valid() const noexcept { return value_ != 0; }
+  uint64_t Value() const noexcept { return value_; }
+
+  bool operator==(const BindingId &o) const noexcept {
+    return value_ == o.value_;
+  }
+  bool operator!=(const BindingId &o) const noexcept {
+    return value_ != o.value_;
+  }
+
+ private:
+  friend class detail::SlotTable;
+
+  BindingId(uint32_t index, uint32_t generation) noexcept
+      : value_(uint64_t(generation) << 32 | index) {}
+
+  uint32_t Index() const noexcept { return uint32_t(value_); }
+  uint32_t Generation() const noexcept { return uint32_t(value_ >> 32); }
+
+  uint64_t value_ = 0;
+};
+
 }  // namespace evtsigslot
 
 #endif /* end of include guard: EVTSIGSLOT_CONNECTION */
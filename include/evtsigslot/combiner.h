@@ -0,0 +1,130 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2021 Uskrai
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef EVTSIGSLOT_COMBINER
+#define EVTSIGSLOT_COMBINER
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace evtsigslot {
+
+/**
+ * Combiner passed to Signal::Emit is called with the result of each slot,
+ * newest first, and returns false to stop the dispatch. Emit returns the
+ * combiner so its value can be read.
+ */
+
+/**
+ * @brief: Keep the first result that tests true, like a non empty optional
+ * or pointer, and stop there
+ */
+template <typename Result>
+struct FirstNonEmpty {
+  Result value{};
+
+  bool operator()(Result&& result) {
+    if (!result) return true;
+    value = std::move(result);
+    return false;
+  }
+};
+
+/**
+ * @brief: true once a slot returns true, later slot isn't called
+ */
+struct AnyOf {
+  bool value = false;
+
+  bool operator()(bool result) noexcept {
+    value = result;
+    return !result;
+  }
+};
+
+/**
+ * @brief: false once a slot returns false, later slot isn't called
+ */
+struct AllOf {
+  bool value = true;
+
+  bool operator()(bool result) noexcept {
+    value = result;
+    return result;
+  }
+};
+
+template <typename Result>
+struct Sum {
+  Result value{};
+
+  bool operator()(Result&& result) {
+    value += std::move(result);
+    return true;
+  }
+};
+
+/**
+ * @brief: Collect the result of every slot, the first Capacity are kept in
+ * place and every result moves to the heap once there are more
+ */
+template <typename Result, size_t Capacity>
+struct Collect {
+  static_assert(Capacity > 0, "Collect needs room for one result");
+
+  std::array<Result, Capacity> values{};
+  std::vector<Result> spill;
+  size_t size = 0;
+
+  bool operator()(Result&& result) {
+    if (size < Capacity) {
+      values[size++] = std::move(result);
+      return true;
+    }
+
+    // kept contiguous so the result are still read as one range
+    if (size == Capacity)
+      spill.assign(std::make_move_iterator(values.begin()),
+                   std::make_move_iterator(values.end()));
+    spill.push_back(std::move(result));
+    ++size;
+    return true;
+  }
+
+  const Result* begin() const noexcept {
+    return size > Capacity ? spill.data() : values.data();
+  }
+  const Result* end() const noexcept { return begin() + size; }
+
+  const Result& operator[](size_t index) const noexcept {
+    return begin()[index];
+  }
+};
+
+}  // namespace evtsigslot
+
+#endif /* end of include guard: EVTSIGSLOT_COMBINER */
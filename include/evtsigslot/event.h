@@ -40,8 +40,12 @@ class EmptyEvent {
   void Skip(bool skip = true) { is_skipped_ = skip; }
   bool IsSkipped() const { return is_skipped_; }
 
+  /**
+   * @brief: Stop propagation, no other slot is called even in the remaining
+   * group, unlike not skipping which only ends the current group
+   */
   void Veto() { vetoed_ = true; }
-  bool IsAllowed() const { return vetoed_; }
+  bool IsAllowed() const { return !vetoed_; }
 };
 //
 }  // namespace internal
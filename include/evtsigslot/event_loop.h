@@ -0,0 +1,278 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2021 Uskrai
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef EVTSIGSLOT_EVENT_LOOP
+#define EVTSIGSLOT_EVENT_LOOP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <evtsigslot/timer_wheel.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#define EVTSIGSLOT_HAS_EVENTFD
+#endif
+
+namespace evtsigslot {
+
+/**
+ * @brief: Object with queued event that can be drained by EventLoop
+ */
+struct Drainable {
+  virtual ~Drainable() = default;
+  virtual void Drain() = 0;
+};
+
+/**
+ * @brief: Thread context owning a task queue that is drained on one thread.
+ * Slot binded with an EventLoop is always called on the loop thread, and
+ * Signal attached to an EventLoop is only drained by the loop.
+ *
+ * On Linux the loop owns an eventfd that is signaled once per batch of posted
+ * work, Fd can be added to an existing epoll set and ProcessPending called
+ * when it is readable.
+ *
+ * The loop also owns a TimerWheel that is advanced by ProcessPending, when
+ * driving the loop from epoll the timeout should not exceed its tick while
+ * timer is pending.
+ */
+class EventLoop {
+ public:
+  using task_type = std::function<void()>;
+
+  /**
+   * @brief: Loop is owned by the constructing thread until Run is called
+   */
+  EventLoop() : thread_id_(std::this_thread::get_id()), notified_(false) {
+#ifdef EVTSIGSLOT_HAS_EVENTFD
+    fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+  }
+
+  ~EventLoop() {
+#ifdef EVTSIGSLOT_HAS_EVENTFD
+    if (fd_ >= 0) close(fd_);
+#endif
+  }
+
+  EventLoop(const EventLoop&) = delete;
+  EventLoop& operator=(const EventLoop&) = delete;
+
+  /**
+   * @brief: File descriptor readable when there is pending work, -1 if not
+   * supported
+   */
+  int Fd() const noexcept { return fd_; }
+
+  TimerWheel& Timers() noexcept { return timers_; }
+
+  /**
+   * @brief: Queue task to be run on the loop thread
+   * @param: task callable without argument
+   */
+  void Post(task_type task) {
+    {
+      locker_type locker(mutex_);
+      tasks_.emplace_back(std::move(task));
+    }
+    Notify();
+  }
+
+  /**
+   * @brief: Mark drainable as ready, it should not be scheduled again until
+   * its Drain is called
+   */
+  void Schedule(Drainable* drainable) {
+    {
+      locker_type locker(mutex_);
+      ready_.push_back(drainable);
+    }
+    Notify();
+  }
+
+  /**
+   * @brief: Remove drainable from ready list and wait for its Drain in
+   * flight, unless the drain runs on the calling thread. Drainable can be
+   * destroyed once this returns.
+   */
+  void Cancel(Drainable* drainable) {
+    std::unique_lock<std::mutex> locker(mutex_);
+    ready_.erase(std::remove(ready_.begin(), ready_.end(), drainable),
+                 ready_.end());
+    batch_.erase(std::remove(batch_.begin(), batch_.end(), drainable),
+                 batch_.end());
+    drained_.wait(locker, [&] {
+      return drainer_ == std::this_thread::get_id() ||
+             std::find(draining_.begin(), draining_.end(), drainable) ==
+                 draining_.end();
+    });
+  }
+
+  bool IsInLoopThread() const noexcept {
+    return thread_id_.load() == std::this_thread::get_id();
+  }
+
+  /**
+   * @brief: Expire due timer, drain every ready signal and run every pending
+   * task on the calling thread, which should be the loop thread
+   *
+   * @return: number of timer expired, signal drained and task run
+   */
+  size_t ProcessPending() {
+    // reset the fd, then clear the notification before taking the batch:
+    // work added before the clear is in the batch, work added after it
+    // signals the fd again
+#ifdef EVTSIGSLOT_HAS_EVENTFD
+    if (fd_ >= 0) {
+      eventfd_t value;
+      eventfd_read(fd_, &value);
+    }
+#endif
+    notified_.store(false);
+
+    size_t expired = timers_.Advance();
+
+    std::vector<task_type> tasks;
+    {
+      locker_type locker(mutex_);
+      tasks.swap(tasks_);
+      // ProcessPending called by a drain takes what is left of the batch
+      batch_.insert(batch_.end(), ready_.begin(), ready_.end());
+      ready_.clear();
+    }
+
+    // drainable is taken one at a time so Cancel can remove the rest
+    struct draining_type {
+      EventLoop& loop;
+      Drainable* drainable;
+
+      explicit draining_type(EventLoop& l) : loop(l), drainable(nullptr) {
+        locker_type locker(loop.mutex_);
+        if (loop.batch_.empty()) return;
+        drainable = loop.batch_.front();
+        loop.batch_.pop_front();
+        loop.draining_.push_back(drainable);
+        loop.drainer_ = std::this_thread::get_id();
+      }
+
+      ~draining_type() {
+        if (!drainable) return;
+        {
+          locker_type locker(loop.mutex_);
+          loop.draining_.pop_back();
+          if (loop.draining_.empty()) loop.drainer_ = std::thread::id();
+        }
+        loop.drained_.notify_all();
+      }
+    };
+
+    size_t drained = 0;
+    while (true) {
+      draining_type draining(*this);
+      if (!draining.drainable) break;
+      draining.drainable->Drain();
+      ++drained;
+    }
+
+    for (auto& task : tasks) task();
+    return expired + drained + tasks.size();
+  }
+
+  /**
+   * @brief: Make the calling thread the loop thread and run task until Stop
+   * is called, task posted before Stop is still run
+   */
+  void Run() {
+    thread_id_.store(std::this_thread::get_id());
+
+    while (true) {
+      {
+        std::unique_lock<std::mutex> locker(mutex_);
+        auto has_work = [&] {
+          return stop_ || !tasks_.empty() || !ready_.empty();
+        };
+
+        if (timers_.Count() == 0)
+          cond_.wait(locker, has_work);
+        else
+          cond_.wait_for(locker, timers_.TickDuration(), has_work);
+
+        if (stop_ && tasks_.empty() && ready_.empty()) {
+          stop_ = false;
+          return;
+        }
+      }
+      ProcessPending();
+    }
+  }
+
+  void Stop() {
+    {
+      locker_type locker(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+  }
+
+ private:
+  using locker_type = std::scoped_lock<std::mutex>;
+
+  // signal the fd and wake Run once until the next ProcessPending, work
+  // posted meanwhile is taken by the same batch
+  void Notify() {
+    if (notified_.exchange(true)) return;
+#ifdef EVTSIGSLOT_HAS_EVENTFD
+    if (fd_ >= 0) eventfd_write(fd_, 1);
+#endif
+    cond_.notify_one();
+  }
+
+  std::atomic<std::thread::id> thread_id_;
+  std::atomic_bool notified_;
+  int fd_ = -1;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<task_type> tasks_;
+  std::vector<Drainable*> ready_;
+  // taken by ProcessPending and not drained yet, drain in flight on
+  // drainer_, nested when a drain calls ProcessPending
+  std::deque<Drainable*> batch_;
+  std::vector<Drainable*> draining_;
+  std::thread::id drainer_;
+  std::condition_variable drained_;
+  bool stop_ = false;
+  TimerWheel timers_;
+};
+
+}  // namespace evtsigslot
+
+#endif /* end of include guard: EVTSIGSLOT_EVENT_LOOP */
@@ -171,12 +171,27 @@ func_ptr get_function_ptr(const T& t) {
  */
 using obj_ptr = const void*;
 
-template <typename T>
-obj_ptr get_object_ptr(const T& t);
-
 template <typename T, typename = void>
 struct object_pointer {
   static obj_ptr get(const T&) { return nullptr; }
 };
 
+template <typename T>
+struct object_pointer<T*> {
+  static obj_ptr get(const T* t) { return reinterpret_cast<obj_ptr>(t); }
+};
+
+template <typename T>
+struct object_pointer<T,
+                      std::enable_if_t<trait::is_weak_ptr_compatible_v<T>>> {
+  static obj_ptr get(const T& t) {
+    return to_weak(t).lock().get();
+  }
+};
+
+template <typename T>
+obj_ptr get_object_ptr(const T& t) {
+  return object_pointer<T>::get(t);
+}
+
 }  // namespace evtsigslot
@@ -0,0 +1,307 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2021 Uskrai
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef EVTSIGSLOT_HAZARD
+#define EVTSIGSLOT_HAZARD
+
+#include <evtsigslot/mutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace evtsigslot {
+
+namespace detail {
+
+/**
+ * @brief: Process wide hazard pointer domain. Reader publishes the pointer it
+ * is about to read in a hazard record and writer retires the object it
+ * replaced instead of freeing it, retired object is reclaimed once no record
+ * holds it.
+ *
+ * Every Retire scans the records, so object still retired is held by a
+ * record and a reader stalled inside its read only keeps the one object it
+ * protects alive. Only reader whose object was replaced while it read, and
+ * so may be its last holder, scans again on release, unless kCollectThreshold
+ * object is pending. It never waits for the domain lock.
+ */
+class HazardDomain {
+ public:
+  static constexpr size_t kCollectThreshold = 64;
+
+  // intrusive node of object waiting to be reclaimed
+  struct Retired {
+    Retired* next = nullptr;
+    void (*reclaim)(Retired*) noexcept = nullptr;
+    const void* owner = nullptr;
+  };
+
+ private:
+  struct EVTSIGSLOT_CACHE_ALIGNED Record {
+    std::atomic<const void*> ptr{nullptr};
+    std::atomic_bool active{true};
+    Record* next = nullptr;
+    // free record owned by the same thread
+    Record* local_next = nullptr;
+  };
+
+ public:
+  // never destroyed so a static signal can still retire at exit
+  static HazardDomain& Instance() {
+    static HazardDomain* domain = new HazardDomain;
+    return *domain;
+  }
+
+  HazardDomain(const HazardDomain&) = delete;
+  HazardDomain& operator=(const HazardDomain&) = delete;
+
+  /**
+   * @brief: Hazard record held by the calling thread for the lifetime of
+   * the guard, nested guard takes another record
+   */
+  class Guard {
+   public:
+    Guard() : record_(Instance().Acquire()) {}
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+    ~Guard() {
+      auto ptr = record_->ptr.load(std::memory_order_relaxed);
+      record_->ptr.store(nullptr, std::memory_order_seq_cst);
+      auto& domain = Instance();
+      domain.Release(record_);
+
+      auto pending = domain.count_.load(std::memory_order_relaxed);
+      if (pending >= kCollectThreshold ||
+          (pending && ptr && source_ && load_(source_) != ptr))
+        domain.TryCollect();
+    }
+
+    /**
+     * @brief: Load source and keep the loaded object from being reclaimed
+     * until the guard is destroyed or protects another pointer
+     */
+    template <typename T>
+    T* Protect(const std::atomic<T*>& source) noexcept {
+      source_ = &source;
+      load_ = [](const void* source) noexcept -> const void* {
+        return static_cast<const std::atomic<T*>*>(source)->load(
+            std::memory_order_relaxed);
+      };
+
+      auto ptr = source.load(std::memory_order_relaxed);
+      while (true) {
+        record_->ptr.store(ptr, std::memory_order_seq_cst);
+        auto again = source.load(std::memory_order_seq_cst);
+        if (again == ptr) return ptr;
+        ptr = again;
+      }
+    }
+
+    // source is being destroyed, release doesn't reload it
+    void Forget() noexcept { source_ = nullptr; }
+
+   private:
+    Record* record_;
+    // last protected source, reloaded on release
+    const void* source_ = nullptr;
+    const void* (*load_)(const void*) noexcept = nullptr;
+  };
+
+  /**
+   * @brief: Reclaim object once no record holds it, object should already
+   * be unreachable from its source and be the address reader protects.
+   * Reclaim may run on the calling thread, so it should not be called with
+   * a lock reclaim could take.
+   */
+  void Retire(Retired* object, void (*reclaim)(Retired*) noexcept,
+              const void* owner) {
+    object->reclaim = reclaim;
+    object->owner = owner;
+
+    Retired* ready = nullptr;
+    {
+      std::scoped_lock<std::mutex> locker(mutex_);
+      object->next = retired_;
+      retired_ = object;
+      count_.fetch_add(1, std::memory_order_relaxed);
+      ready = Collect();
+    }
+    Run(ready);
+  }
+
+  /**
+   * @brief: Unlink every object retired by owner without checking record,
+   * owner should no longer be read by another thread. Object of owner already
+   * unlinked by another thread may still be reclaiming when this returns.
+   *
+   * @return: unlinked object chained by next, the caller reclaims it
+   */
+  Retired* Take(const void* owner) {
+    Retired* ready = nullptr;
+    std::scoped_lock<std::mutex> locker(mutex_);
+    Unlink(ready, [&](Retired* it) { return it->owner == owner; });
+    return ready;
+  }
+
+  // object retired and not reclaimed yet
+  size_t Pending() const noexcept {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  size_t Records() const noexcept {
+    return records_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  HazardDomain() = default;
+
+  static Record*& LocalFree() noexcept {
+    // record go back to the domain when their thread exits
+    struct cache_type {
+      Record* head = nullptr;
+      ~cache_type() {
+        auto& idle = Instance().idle_;
+        for (; head; head = head->local_next) {
+          head->active.store(false, std::memory_order_release);
+          idle.fetch_add(1, std::memory_order_release);
+        }
+      }
+    };
+    thread_local cache_type cache;
+    return cache.head;
+  }
+
+  Record* Acquire() {
+    auto& free = LocalFree();
+    if (auto record = free) {
+      free = record->local_next;
+      return record;
+    }
+
+    // record is only left by exited thread
+    for (auto record = head_.load(std::memory_order_acquire);
+         record && idle_.load(std::memory_order_acquire);
+         record = record->next) {
+      bool active = false;
+      if (!record->active.load(std::memory_order_relaxed) &&
+          record->active.compare_exchange_strong(active, true)) {
+        idle_.fetch_sub(1, std::memory_order_relaxed);
+        return record;
+      }
+    }
+
+    auto record = new Record;
+    record->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(record->next, record,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+    records_.fetch_add(1, std::memory_order_relaxed);
+    return record;
+  }
+
+  void Release(Record* record) noexcept {
+    auto& free = LocalFree();
+    record->local_next = free;
+    free = record;
+  }
+
+  void TryCollect() noexcept {
+    std::unique_lock<std::mutex> locker(mutex_, std::try_to_lock);
+    if (!locker) return;
+
+    Retired* ready = nullptr;
+    try {
+      ready = Collect();
+    } catch (...) {
+      // hazard list couldn't grow, the next Retire scans again
+      return;
+    }
+    locker.unlock();
+    Run(ready);
+  }
+
+  // should be called with mutex_ held
+  template <typename Pred>
+  void Unlink(Retired*& ready, Pred&& pred) {
+    for (auto it = &retired_; *it;) {
+      auto object = *it;
+      if (!pred(object)) {
+        it = &object->next;
+        continue;
+      }
+      *it = object->next;
+      object->next = ready;
+      ready = object;
+      count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  // should be called with mutex_ held, unlink retired object no record holds
+  Retired* Collect() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    hazards_.clear();
+    for (auto record = head_.load(std::memory_order_acquire); record;
+         record = record->next)
+      if (auto ptr = record->ptr.load(std::memory_order_seq_cst))
+        hazards_.push_back(ptr);
+    std::sort(hazards_.begin(), hazards_.end());
+
+    Retired* ready = nullptr;
+    Unlink(ready, [&](Retired* it) {
+      return !std::binary_search(hazards_.begin(), hazards_.end(),
+                                 static_cast<const void*>(it));
+    });
+    return ready;
+  }
+
+  // reclaim is run without the lock so it can retire again
+  static void Run(Retired* ready) noexcept {
+    while (ready) {
+      auto next = ready->next;
+      ready->reclaim(ready);
+      ready = next;
+    }
+  }
+
+  std::atomic<Record*> head_{nullptr};
+  std::atomic_size_t records_{0}, idle_{0};
+
+  std::mutex mutex_;
+  Retired* retired_ = nullptr;
+  // written with mutex_ held
+  std::atomic_size_t count_{0};
+  // reused by every scan
+  std::vector<const void*> hazards_;
+};
+
+}  // namespace detail
+
+}  // namespace evtsigslot
+
+#endif /* end of include guard: EVTSIGSLOT_HAZARD */
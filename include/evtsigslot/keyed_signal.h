@@ -0,0 +1,207 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2021 Uskrai
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef EVTSIGSLOT_KEYED_SIGNAL
+#define EVTSIGSLOT_KEYED_SIGNAL
+
+#include <evtsigslot/signal.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace evtsigslot {
+
+/**
+ * @brief: Signal whose slot is binded under a key, emission only dispatch to
+ * slot of the emitted key found through a hash index.
+ *
+ * Each key owns a Signal, so event of the same key keep their order while
+ * event of different key are queued and drained independently. Key entry is
+ * erased once its last slot is unbinded or expired, so transient key don't
+ * pile up. Emission takes the shared lock and a reference on the key signal
+ * for the time of the dispatch, so the entry can be erased meanwhile.
+ */
+template <typename Key, typename Emitted = void,
+          typename Hash = std::hash<Key>>
+class KeyedSignal {
+ public:
+  using key_type = Key;
+  using value_type = Emitted;
+  using signal_type = Signal<Emitted>;
+
+  KeyedSignal() : block_(false) {}
+  KeyedSignal(const KeyedSignal&) = delete;
+  KeyedSignal& operator=(const KeyedSignal&) = delete;
+
+  /**
+   * @brief: Bind slot under key, argument is the same as Signal::Bind
+   */
+  template <typename... Args>
+  Binding Bind(const Key& key, Args&&... args) {
+    // bind under the lock so the entry can't be erased before its slot is in
+    {
+      std::shared_lock<std::shared_mutex> locker(mutex_);
+      auto it = signals_.find(key);
+      if (it != signals_.end())
+        return it->second->Bind(std::forward<Args>(args)...);
+    }
+
+    std::unique_lock<std::shared_mutex> locker(mutex_);
+    auto& signal = signals_[key];
+    if (!signal) signal = std::make_shared<entry_type>(*this, key);
+    return signal->Bind(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  ScopedBinding BindScoped(const Key& key, Args&&... args) {
+    return Bind(key, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief: Queue event to slot binded under key, nothing is allocated when
+   * the key has no slot
+   */
+  template <typename... T>
+  void Queue(const Key& key, T&&... val) {
+    if (block_) return;
+    if (auto signal = Find(key)) signal->Queue(std::forward<T>(val)...);
+  }
+
+  template <typename... T>
+  void operator()(const Key& key, T&&... val) {
+    Queue(key, std::forward<T>(val)...);
+  }
+
+  /**
+   * @brief: Unbind every slot binded under key
+   * @return: Unbinded slot
+   */
+  size_t Unbind(const Key& key) {
+    auto signal = Find(key);
+    if (!signal) return 0;
+
+    auto count = signal->CountSlot();
+    signal->UnbindAll();
+    Erase(key, signal.get());
+    return count;
+  }
+
+  /**
+   * @brief: Unbind slot under key, argument is the same as Signal::Unbind
+   */
+  template <typename Arg, typename... Args>
+  size_t Unbind(const Key& key, const Arg& arg, const Args&... args) {
+    auto signal = Find(key);
+    if (!signal) return 0;
+
+    auto count = signal->Unbind(arg, args...);
+    Erase(key, signal.get());
+    return count;
+  }
+
+  void UnbindAll() {
+    decltype(signals_) signals;
+    {
+      std::unique_lock<std::shared_mutex> locker(mutex_);
+      signals.swap(signals_);
+    }
+    for (auto& it : signals) it.second->UnbindAll();
+  }
+
+  void Block() noexcept { block_.store(true); }
+  void Unblock() noexcept { block_.store(false); }
+
+  size_t CountSlot(const Key& key) {
+    auto signal = Find(key);
+    return signal ? signal->CountSlot() : 0;
+  }
+
+  size_t CountSlot() {
+    std::shared_lock<std::shared_mutex> locker(mutex_);
+    size_t count = 0;
+    for (auto& it : signals_) count += it.second->CountSlot();
+    return count;
+  }
+
+  size_t CountKey() const {
+    std::shared_lock<std::shared_mutex> locker(mutex_);
+    return signals_.size();
+  }
+
+ private:
+  // key signal telling its KeyedSignal when one of its slot goes away
+  class entry_type : public signal_type {
+   public:
+    entry_type(KeyedSignal& owner, const Key& key) : owner_(owner), key_(key) {}
+
+   protected:
+    // erasing may destroy the signal, so it is the last thing done
+    void Clean(detail::SlotState* state) override {
+      signal_type::Clean(state);
+      owner_.Erase(key_, this);
+    }
+
+    void CleanLater(detail::SlotState* state) override {
+      signal_type::CleanLater(state);
+      owner_.Erase(key_, this);
+    }
+
+   private:
+    KeyedSignal& owner_;
+    Key key_;
+  };
+
+  // the lock is never held while the inner signal is used so slot can bind
+  // new key while being called
+  std::shared_ptr<entry_type> Find(const Key& key) const {
+    std::shared_lock<std::shared_mutex> locker(mutex_);
+    auto it = signals_.find(key);
+    return it != signals_.end() ? it->second : nullptr;
+  }
+
+  // erase the entry of key if it is still signal and has no slot left, the
+  // entry is released without the lock since it may be the last reference
+  void Erase(const Key& key, const signal_type* signal) {
+    std::shared_ptr<entry_type> erased;
+    std::unique_lock<std::shared_mutex> locker(mutex_);
+    auto it = signals_.find(key);
+    if (it == signals_.end() || it->second.get() != signal ||
+        signal->Stats().slots != 0)
+      return;
+
+    erased = std::move(it->second);
+    signals_.erase(it);
+  }
+
+  std::unordered_map<Key, std::shared_ptr<entry_type>, Hash> signals_;
+  mutable std::shared_mutex mutex_;
+  std::atomic_bool block_;
+};
+
+}  // namespace evtsigslot
+
+#endif /* end of include guard: EVTSIGSLOT_KEYED_SIGNAL */
@@ -22,8 +22,67 @@
  *  IN THE SOFTWARE.
  */
 
-namespace fmr {
+#ifndef EVTSIGSLOT_MUTEX
+#define EVTSIGSLOT_MUTEX
 
-namespace detail {}  // namespace detail
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 
-}  // namespace fmr
+/**
+ * Alignment keeping state written by one thread off the cache line other
+ * thread read, can be defined to 0 before any include to favor size over
+ * false sharing.
+ */
+#ifndef EVTSIGSLOT_CACHE_LINE
+#define EVTSIGSLOT_CACHE_LINE 64
+#endif
+
+#if EVTSIGSLOT_CACHE_LINE
+#define EVTSIGSLOT_CACHE_ALIGNED alignas(EVTSIGSLOT_CACHE_LINE)
+#else
+#define EVTSIGSLOT_CACHE_ALIGNED
+#endif
+
+namespace evtsigslot {
+
+namespace detail {
+
+/**
+ * @brief: Fixed pool of mutex shared by every object instead of each object
+ * owning its own, an object locks the stripe picked from its address.
+ *
+ * Unrelated object may share a stripe, so a stripe should never be held
+ * while locking the stripe of another object.
+ */
+class MutexStripe {
+ public:
+  static constexpr size_t kStripes = 256;
+
+  /**
+   * @param: object owner of the lock
+   * @param: which index of the lock among those owned by object
+   */
+  static std::mutex& For(const void* object, size_t which = 0) noexcept {
+    // object is at least 8 byte aligned, mix the high bit down
+    auto hash = reinterpret_cast<uintptr_t>(object) >> 3;
+    hash ^= hash >> 11;
+    hash *= uintptr_t(0x9e3779b97f4a7c15ull);
+    hash ^= hash >> 29;
+    return pool_[(hash + which) % kStripes].mutex;
+  }
+
+ private:
+  // one stripe per cache line so thread on different stripe don't contend
+  struct EVTSIGSLOT_CACHE_ALIGNED stripe_type {
+    std::mutex mutex;
+  };
+
+  inline static stripe_type pool_[kStripes];
+};
+
+}  // namespace detail
+
+}  // namespace evtsigslot
+
+#endif /* end of include guard: EVTSIGSLOT_MUTEX */
@@ -0,0 +1,199 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2021 Uskrai
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef EVTSIGSLOT_OBSERVER
+#define EVTSIGSLOT_OBSERVER
+
+#include <evtsigslot/traits.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace evtsigslot {
+
+class Observer;
+
+namespace detail {
+
+/**
+ * @brief: Intrusive node embedded in slot binded with an Observer
+ */
+class ObserverLink {
+ public:
+  virtual ~ObserverLink() = default;
+
+  bool IsLinked() const noexcept { return next_ != this; }
+
+  void Unlink() noexcept {
+    prev_->next_ = next_;
+    next_->prev_ = prev_;
+    prev_ = next_ = this;
+  }
+
+  void PushBack(ObserverLink* link) noexcept {
+    link->prev_ = prev_;
+    link->next_ = this;
+    prev_->next_ = link;
+    prev_ = link;
+  }
+
+  /**
+   * @brief: Keep the slot alive, return empty if it is being destroyed or is
+   * the list head
+   */
+  virtual std::shared_ptr<void> Retain() { return nullptr; }
+
+  /**
+   * @brief: Unbind the slot on behalf of the observer
+   */
+  virtual void Release() {}
+
+ private:
+  friend class ::evtsigslot::Observer;
+
+  ObserverLink* prev_ = this;
+  ObserverLink* next_ = this;
+};
+
+// shared with slot so it can unlink itself after the observer is gone
+struct ObserverState {
+  std::mutex mutex;
+  ObserverLink head;
+
+  // slot call running on the observer, on any thread
+  std::atomic_size_t calls{0};
+};
+
+/**
+ * @brief: Slot call running on an observer, counted so UnbindAll can wait
+ * until the observer isn't used anymore. Calls of the current thread are
+ * chained so UnbindAll made from inside a slot doesn't wait for itself.
+ */
+class ObserverCall {
+ public:
+  explicit ObserverCall(ObserverState& state) noexcept
+      : state_(state), prev_(Top()) {
+    state_.calls.fetch_add(1);
+    Top() = this;
+  }
+
+  ~ObserverCall() {
+    Top() = prev_;
+    state_.calls.fetch_sub(1, std::memory_order_release);
+  }
+
+  ObserverCall(const ObserverCall&) = delete;
+  ObserverCall& operator=(const ObserverCall&) = delete;
+
+  /**
+   * @brief: Wait until every call on state made by another thread returns
+   */
+  static void Wait(const ObserverState& state) noexcept {
+    size_t own = 0;
+    for (auto it = Top(); it; it = it->prev_)
+      if (&it->state_ == &state) ++own;
+
+    while (state.calls.load() > own) std::this_thread::yield();
+  }
+
+ private:
+  static ObserverCall*& Top() noexcept {
+    thread_local ObserverCall* top = nullptr;
+    return top;
+  }
+
+  ObserverState& state_;
+  ObserverCall* prev_;
+};
+
+}  // namespace detail
+
+/**
+ * @brief: Base class for object binded by raw pointer that unbind every slot
+ * binded to itself when destroyed. Each slot is linked into the observer so
+ * finding them costs only the observer own binding, each signal still
+ * removes them with one scan of its list, together with its other unbinded
+ * slot.
+ *
+ * Member of derived class is destroyed before this destructor run, derived
+ * class should call UnbindAll in its own destructor when its signal may be
+ * emitted from another thread. UnbindAll returns once the slot call already
+ * running on other thread are done, so they never see a destroyed member.
+ */
+class Observer : public detail::observer_type {
+ public:
+  Observer() : state_(std::make_shared<detail::ObserverState>()) {}
+
+  // binding belongs to the object and is not copied
+  Observer(const Observer&) : Observer() {}
+  Observer& operator=(const Observer&) noexcept { return *this; }
+
+  virtual ~Observer() { UnbindAll(); }
+
+  void UnbindAll() {
+    std::vector<std::pair<std::shared_ptr<void>, detail::ObserverLink*>> slots;
+    {
+      std::scoped_lock<std::mutex> locker(state_->mutex);
+      auto& head = state_->head;
+      while (head.IsLinked()) {
+        auto link = head.next_;
+        link->Unlink();
+        if (auto slot = link->Retain())
+          slots.emplace_back(std::move(slot), link);
+      }
+    }
+
+    // unbind outside the lock, slot being destroyed can then unlink itself
+    for (auto& [slot, link] : slots) link->Release();
+
+    // a call that passed its binded check before the release may still run
+    detail::ObserverCall::Wait(*state_);
+  }
+
+  size_t CountBinding() const {
+    std::scoped_lock<std::mutex> locker(state_->mutex);
+    size_t count = 0;
+    for (auto it = state_->head.next_; it != &state_->head; it = it->next_)
+      ++count;
+    return count;
+  }
+
+ private:
+  template <typename, typename, typename, typename>
+  friend class SlotObserver;
+
+  const std::shared_ptr<detail::ObserverState>& State() const noexcept {
+    return state_;
+  }
+
+  std::shared_ptr<detail::ObserverState> state_;
+};
+
+}  // namespace evtsigslot
+
+#endif /* end of include guard: EVTSIGSLOT_OBSERVER */
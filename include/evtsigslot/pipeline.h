@@ -0,0 +1,130 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2021 Uskrai
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef EVTSIGSLOT_PIPELINE
+#define EVTSIGSLOT_PIPELINE
+
+#include <evtsigslot/binding.h>
+#include <evtsigslot/event.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace evtsigslot {
+
+namespace detail {
+
+struct pipeline_identity {
+  template <typename T, typename Next>
+  void operator()(T& value, Next&& next) const {
+    next(value);
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief: Filter and Map stage chained on a Signal. Every stage is a callable
+ * taking the value and the next stage, so Bind compose the whole chain into
+ * one slot callable that the compiler can inline.
+ *
+ * Pipeline can be kept and binded more than once, each Bind copies the
+ * stages.
+ */
+template <typename SignalType, typename Stage>
+class Pipeline {
+ public:
+  Pipeline(SignalType& signal, Stage stage)
+      : signal_(signal), stage_(std::move(stage)) {}
+
+  /**
+   * @brief: Only pass value for which predicate return true
+   */
+  template <typename Predicate>
+  auto Filter(Predicate&& predicate) const {
+    auto stage = [prev = stage_,
+                  predicate = std::forward<Predicate>(predicate)](
+                     auto& value, auto&& next) mutable {
+      prev(value, [&](auto& result) {
+        if (predicate(result)) next(result);
+      });
+    };
+    return Pipeline<SignalType, decltype(stage)>(signal_, std::move(stage));
+  }
+
+  /**
+   * @brief: Pass the value returned by function instead
+   */
+  template <typename Function>
+  auto Map(Function&& function) const {
+    auto stage = [prev = stage_, function = std::forward<Function>(function)](
+                     auto& value, auto&& next) mutable {
+      prev(value, [&](auto& result) {
+        decltype(auto) mapped = function(result);
+        next(mapped);
+      });
+    };
+    return Pipeline<SignalType, decltype(stage)>(signal_, std::move(stage));
+  }
+
+  /**
+   * @brief: Bind handler called with the value passing every stage, handler
+   * can also take no argument. The slot takes the event, so a rejected
+   * event is skipped before anything else and the dispatch goes on as if
+   * the slot wasn't binded. Event passing every stage is handled: it is not
+   * skipped and ends its group like a slot taking Event that doesn't skip.
+   */
+  template <typename Handler>
+  Binding Bind(Handler&& handler) const {
+    using event_ref = Event<typename SignalType::value_type>&;
+
+    return signal_.Bind([stage = stage_,
+                         handler = std::forward<Handler>(handler)](
+                            event_ref event) mutable {
+      bool passed = false;
+      stage(event.Get(), [&](auto& result) {
+        passed = true;
+        if constexpr (std::is_invocable_v<std::decay_t<Handler>&,
+                                          decltype(result)>)
+          handler(result);
+        else
+          handler();
+      });
+      if (!passed) event.Skip();
+    });
+  }
+
+  template <typename Handler>
+  ScopedBinding BindScoped(Handler&& handler) const {
+    return Bind(std::forward<Handler>(handler));
+  }
+
+ private:
+  SignalType& signal_;
+  Stage stage_;
+};
+
+}  // namespace evtsigslot
+
+#endif /* end of include guard: EVTSIGSLOT_PIPELINE */
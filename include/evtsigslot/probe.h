@@ -0,0 +1,55 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2021 Uskrai
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef EVTSIGSLOT_PROBE
+#define EVTSIGSLOT_PROBE
+
+/**
+ * USDT probe under the evtsigslot provider, compiled in only when
+ * EVTSIGSLOT_USDT is defined. A disabled probe is a single nop, argument is
+ * still evaluated so it should stay cheap to compute.
+ *
+ *   queue(signal, depth)             event queued, depth after queueing
+ *   drain__start(signal, depth)      ProcessEvent start draining
+ *   drain__done(signal, drained)     ProcessEvent done, event drained
+ *   slot__entry(signal, slot)        slot called by the signal
+ *   slot__return(signal, slot)       slot returned
+ *   bind(signal, slot)               slot added to the signal
+ *   unbind(signal, slot)             slot removed from the signal
+ *
+ * e.g. bpftrace -e 'usdt:./app:evtsigslot:queue { @[arg0] = hist(arg1); }'
+ */
+#ifdef EVTSIGSLOT_USDT
+#if !__has_include(<sys/sdt.h>)
+#error "EVTSIGSLOT_USDT requires <sys/sdt.h> (systemtap-sdt-dev)"
+#endif
+
+#include <sys/sdt.h>
+
+#define EVTSIGSLOT_PROBE2(name, a1, a2) DTRACE_PROBE2(evtsigslot, name, a1, a2)
+#else
+#define EVTSIGSLOT_PROBE2(name, a1, a2)
+#endif
+
+#endif /* end of include guard: EVTSIGSLOT_PROBE */
@@ -0,0 +1,459 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2021 Uskrai
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef EVTSIGSLOT_ROUTED_SIGNAL
+#define EVTSIGSLOT_ROUTED_SIGNAL
+
+#include <evtsigslot/binding.h>
+#include <evtsigslot/event.h>
+#include <evtsigslot/slot_traits.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace evtsigslot {
+
+/**
+ * @brief: Declarative predicate over a projected value, union of half open
+ * range [lo, hi) where missing bound is unbounded
+ */
+template <typename Value>
+struct Match {
+  struct range_type {
+    std::optional<Value> lo, hi;
+  };
+
+  std::vector<range_type> ranges;
+
+  Match operator|(const Match& o) const {
+    Match ret = *this;
+    ret.ranges.insert(ret.ranges.end(), o.ranges.begin(), o.ranges.end());
+    return ret;
+  }
+};
+
+template <typename Value>
+Match<Value> Any() {
+  return {{{std::nullopt, std::nullopt}}};
+}
+
+template <typename Value>
+Match<Value> AtLeast(Value lo) {
+  return {{{std::move(lo), std::nullopt}}};
+}
+
+template <typename Value>
+Match<Value> Below(Value hi) {
+  return {{{std::nullopt, std::move(hi)}}};
+}
+
+template <typename Value>
+Match<Value> Between(Value lo, Value hi) {
+  return {{{std::move(lo), std::move(hi)}}};
+}
+
+/**
+ * @brief: Match integral or enum value v for which bit v of mask is set
+ */
+template <typename Value>
+Match<Value> OneOf(uint64_t mask) {
+  using underlying =
+      typename std::conditional_t<std::is_enum_v<Value>,
+                                  std::underlying_type<Value>,
+                                  std::common_type<Value>>::type;
+  Match<Value> ret;
+  for (unsigned bit = 0; bit < 64;) {
+    if (!(mask >> bit & 1)) {
+      ++bit;
+      continue;
+    }
+
+    unsigned end = bit;
+    while (end < 64 && (mask >> end & 1)) ++end;
+    ret.ranges.push_back({static_cast<Value>(static_cast<underlying>(bit)),
+                          static_cast<Value>(static_cast<underlying>(end))});
+    bit = end;
+  }
+  return ret;
+}
+
+/**
+ * @brief: Signal routing event by a projection of the emitted value. Slot is
+ * binded with a Match and the signal keeps an interval index over every
+ * Match, so an emission projects the value once, finds its cell with a binary
+ * search and only calls slot matching it.
+ *
+ * The index is rebuilt by the first emission after slot was binded or
+ * half of the slot was unbinded, so binding many slot costs one rebuild.
+ * Unbinded slot skips itself until then, and is kept alive by the index.
+ *
+ * Event is dispatched on the emitting thread without being queued.
+ *
+ * @param: Projection callable or member pointer invoked with const Emitted&
+ */
+template <typename Emitted, typename Projection>
+class RoutedSignal : Cleanable {
+ public:
+  using value_type = Emitted;
+  using key_type = std::decay_t<
+      std::invoke_result_t<const Projection&, const Emitted&>>;
+  using match_type = Match<key_type>;
+
+  /**
+   * @param: resource every slot and index of the signal is allocated from,
+   * it should outlive the signal and every Binding of it
+   */
+  explicit RoutedSignal(
+      Projection projection,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : projection_(std::move(projection)),
+        resource_(resource),
+        entries_(resource),
+        index_(Allocate<index_type>(resource)),
+        block_(false) {}
+
+  RoutedSignal(const RoutedSignal&) = delete;
+  RoutedSignal& operator=(const RoutedSignal&) = delete;
+
+  ~RoutedSignal() { UnbindAll(); }
+
+  template <typename... Caller>
+  using slot_traits_def = slot_traits<trait::typelist<Emitted>, Caller...>;
+
+  template <typename... Caller>
+  static constexpr bool is_callable_v = slot_traits_def<Caller...>::value;
+
+  template <typename... Caller>
+  using slot_caller_type = typename slot_traits_def<Caller...>::type;
+
+  template <typename Callable, typename Class>
+  std::enable_if_t<is_callable_v<Callable, Class>, Binding> Bind(
+      match_type match, Callable&& callable, Class&& class_ptr) {
+    return BindSlot(std::move(match),
+                    Allocate<slot_caller_type<Callable, Class>>(
+                        static_cast<Cleanable&>(*this),
+                        std::forward<Callable>(callable),
+                        std::forward<Class>(class_ptr)));
+  }
+
+  template <typename Callable>
+  std::enable_if_t<is_callable_v<Callable>, Binding> Bind(match_type match,
+                                                          Callable&& callable) {
+    return BindSlot(std::move(match),
+                    Allocate<slot_caller_type<Callable>>(
+                        static_cast<Cleanable&>(*this),
+                        std::forward<Callable>(callable)));
+  }
+
+  template <typename... Args>
+  ScopedBinding BindScoped(Args&&... args) {
+    return Bind(std::forward<Args>(args)...);
+  }
+
+  template <typename... T>
+  std::enable_if_t<std::is_constructible_v<Emitted, T...>, void> operator()(
+      T&&... val) {
+    if (block_) return;
+
+    event_type event(std::forward<T>(val)...);
+    const key_type key = std::invoke(projection_, std::as_const(event.Get()));
+
+    std::shared_ptr<const index_type> index;
+    {
+      locker_type locker(mutex_);
+      if (dirty_) Rebuild();
+      index = index_;
+    }
+
+    auto cell = std::upper_bound(index->bounds.begin(), index->bounds.end(),
+                                 key) -
+                index->bounds.begin();
+
+    for (auto i = index->offsets[cell]; i < index->offsets[cell + 1]; ++i) {
+      auto slot = index->cells[i];
+      event.Skip(false);
+      slot->operator()(event);
+      if (!event.IsSkipped() || !event.IsAllowed()) break;
+    }
+  }
+
+  /**
+   * Unbind all slot binded to Callable
+   *
+   * @return: Unbinded slot
+   */
+  template <typename Callable>
+  std::enable_if_t<(is_callable_v<Callable> || trait::is_pmf_v<Callable>),
+                   size_t>
+  Unbind(const Callable& callable) {
+    return DoUnbindIf(
+        [&](const auto& it) { return it->HasCallable(callable); });
+  }
+
+  /**
+   * Unbind all slot binded to the callable and the object
+   *
+   * @return: Unbinded slot
+   */
+  template <typename Callable, typename Object>
+  std::enable_if_t<is_callable_v<Callable, Object> || trait::is_pmf_v<Callable>,
+                   size_t>
+  Unbind(const Callable& callable, const Object& obj) {
+    auto obj_ptr = get_object_ptr(obj);
+    return DoUnbindIf([&](const auto& it) {
+      return it->HasObject(obj_ptr) && it->HasCallable(callable);
+    });
+  }
+
+  /**
+   * Unbind all slot binded to the object
+   *
+   * @param: class_ptr obj pointer, shared_ptr or weak_ptr
+   *
+   * @return: Unbinded slot
+   */
+  template <typename Class>
+  std::enable_if_t<!is_callable_v<Class> && !trait::is_pmf_v<Class> &&
+                       (trait::is_pointer_v<Class> ||
+                        trait::is_weak_ptr_compatible_v<Class>),
+                   size_t>
+  Unbind(const Class& class_ptr) {
+    auto obj_ptr = get_object_ptr(class_ptr);
+    return DoUnbindIf([&](const auto& it) { return it->HasObject(obj_ptr); });
+  }
+
+  void UnbindAll() {
+    locker_type locker(mutex_);
+    for (auto& entry : entries_)
+      if (entry.slot) entry.slot->Detach();
+    entries_.clear();
+    index_ = Allocate<index_type>(resource_);
+    removed_ = 0;
+    dirty_ = false;
+  }
+
+  void Block() noexcept { block_.store(true); }
+  void Unblock() noexcept { block_.store(false); }
+
+  size_t CountSlot() {
+    locker_type locker(mutex_);
+    return entries_.size() - removed_;
+  }
+
+ private:
+  using event_type = Event<Emitted>;
+  using slot_type = Slot<Emitted>;
+  using slot_ptr = std::shared_ptr<slot_type>;
+  using locker_type = std::scoped_lock<std::mutex>;
+
+  struct entry_type {
+    match_type match;
+    slot_ptr slot;
+  };
+
+  // cell i holds value in [bounds[i - 1], bounds[i]), its slot are
+  // cells[offsets[i], offsets[i + 1]). slots keeps them alive while an
+  // emitter still reads the index
+  struct index_type {
+    explicit index_type(std::pmr::memory_resource* resource)
+        : bounds(resource),
+          slots(resource),
+          offsets(2, 0, resource),
+          cells(resource) {}
+
+    std::pmr::vector<key_type> bounds;
+    std::pmr::vector<slot_ptr> slots;
+    std::pmr::vector<size_t> offsets;
+    std::pmr::vector<slot_type*> cells;
+  };
+
+  template <typename T, typename... Args>
+  std::shared_ptr<T> Allocate(Args&&... args) const {
+    return std::allocate_shared<T>(
+        std::pmr::polymorphic_allocator<T>(resource_),
+        std::forward<Args>(args)...);
+  }
+
+  Binding BindSlot(match_type&& match, slot_ptr&& slot) {
+    Binding bind(slot);
+    locker_type locker(mutex_);
+    entries_.push_back({std::move(match), std::move(slot)});
+    dirty_ = true;
+    return bind;
+  }
+
+  template <typename Cond>
+  size_t DoUnbindIf(Cond func) {
+    locker_type locker(mutex_);
+    size_t count = 0;
+    for (auto& entry : entries_) {
+      if (!entry.slot || !func(entry.slot)) continue;
+      entry.slot->Detach();
+      Remove(entry);
+      ++count;
+    }
+    return count;
+  }
+
+  // should be called with mutex_ held. Entry is only cleared so unbinding
+  // doesn't shift the others, the unbinded slot skips itself so the index
+  // is only rebuilt once half of the entry are cleared
+  void Remove(entry_type& entry) {
+    entry.slot.reset();
+    if (++removed_ * 2 <= entries_.size()) return;
+    Compact();
+    dirty_ = true;
+  }
+
+  // should be called with mutex_ held
+  void Compact() {
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [](const auto& it) { return !it.slot; }),
+                   entries_.end());
+    removed_ = 0;
+  }
+
+  // should be called with mutex_ held
+  void Rebuild() {
+    if (removed_) Compact();
+
+    auto index = Allocate<index_type>(resource_);
+    auto& bounds = index->bounds;
+
+    for (const auto& entry : entries_) {
+      for (const auto& range : entry.match.ranges) {
+        if (range.lo) bounds.push_back(*range.lo);
+        if (range.hi) bounds.push_back(*range.hi);
+      }
+    }
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end(),
+                             [](const auto& a, const auto& b) {
+                               return !(a < b) && !(b < a);
+                             }),
+                 bounds.end());
+    const size_t count = bounds.size() + 1;
+
+    auto cell_of = [&](const key_type& key) -> size_t {
+      return std::upper_bound(bounds.begin(), bounds.end(), key) -
+             bounds.begin();
+    };
+
+    // newest slot is called first like Signal
+    auto entry_at = [&](size_t i) -> const entry_type& {
+      return entries_[entries_.size() - 1 - i];
+    };
+
+    // cell span of every entry, the range of an entry are sorted and
+    // merged so an entry is only added once to a cell
+    std::vector<std::pair<size_t, size_t>> spans;
+    std::vector<size_t> spans_end;
+    spans_end.reserve(entries_.size());
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      const auto& entry = entry_at(i);
+      const size_t begin = spans.size();
+      for (const auto& range : entry.match.ranges) {
+        const size_t first = range.lo ? cell_of(*range.lo) : 0;
+        const size_t last = range.hi ? cell_of(*range.hi) : count;
+        if (first < last) spans.emplace_back(first, last);
+      }
+      std::sort(spans.begin() + begin, spans.end());
+
+      size_t end = begin;
+      for (size_t i = begin; i < spans.size(); ++i) {
+        if (end > begin && spans[i].first <= spans[end - 1].second)
+          spans[end - 1].second = std::max(spans[end - 1].second,
+                                           spans[i].second);
+        else
+          spans[end++] = spans[i];
+      }
+      spans.resize(end);
+      spans_end.push_back(end);
+    }
+
+    // every cell is laid out in one array, sized from the span bounds
+    std::vector<size_t> delta(count + 1);
+    for (const auto& [first, last] : spans) {
+      ++delta[first];
+      --delta[last];
+    }
+    auto& offsets = index->offsets;
+    offsets.assign(count + 1, 0);
+    for (size_t cell = 0, size = 0; cell < count; ++cell) {
+      size += delta[cell];
+      offsets[cell + 1] = offsets[cell] + size;
+    }
+
+    // entry fills its cells in call order
+    index->cells.resize(offsets[count]);
+    index->slots.reserve(entries_.size());
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0, span = 0; i < entries_.size(); ++i) {
+      const auto& slot = entry_at(i).slot;
+      for (; span < spans_end[i]; ++span)
+        for (auto cell = spans[span].first; cell < spans[span].second; ++cell)
+          index->cells[next[cell]++] = slot.get();
+      index->slots.push_back(slot);
+    }
+
+    dirty_ = false;
+    index_ = std::move(index);
+  }
+
+  void Clean(detail::SlotState* state) override {
+    locker_type locker(mutex_);
+    auto it =
+        std::find_if(entries_.begin(), entries_.end(),
+                     [&](const auto& e) { return e.slot.get() == state; });
+    if (it == entries_.end()) return;
+
+    Remove(*it);
+  }
+
+  Projection projection_;
+  std::pmr::memory_resource* resource_;
+  // oldest slot first
+  std::pmr::vector<entry_type> entries_;
+  std::shared_ptr<const index_type> index_;
+  // entry cleared and not erased yet, the slot of cleared entry is held by
+  // index_ until the next rebuild
+  size_t removed_ = 0;
+  // index_ is rebuilt by the next emission
+  bool dirty_ = false;
+  std::mutex mutex_;
+  std::atomic_bool block_;
+};
+
+}  // namespace evtsigslot
+
+#endif /* end of include guard: EVTSIGSLOT_ROUTED_SIGNAL */
@@ -26,82 +26,767 @@
 #define FMR_EVTSIGSLOT_SIGNAL
 
 #include <evtsigslot/binding.h>
-#include <evtsigslot/copy_on_write.h>
+#include <evtsigslot/combiner.h>
 #include <evtsigslot/event.h>
+#include <evtsigslot/event_loop.h>
 #include <evtsigslot/group.h>
+#include <evtsigslot/hazard.h>
+#include <evtsigslot/mutex.h>
+#include <evtsigslot/pipeline.h>
+#include <evtsigslot/probe.h>
+#include <evtsigslot/slot_table.h>
 #include <evtsigslot/slot_traits.h>
+#include <evtsigslot/timer_wheel.h>
+#include <evtsigslot/trace.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <list>
+#include <memory_resource>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <optional>
 #include <queue>
+#include <string>
+#include <thread>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 namespace evtsigslot {
 
-template <typename Emitted = void>
-class Signal : Cleanable {
- protected:
-  using Lockable = std::mutex;
+namespace detail {
+
+/**
+ * @brief: Dispatch nesting of the calling thread across every signal. Drain
+ * nested deeper than its signal allows is deferred here and run once the
+ * outermost dispatch of the thread returns, so recursive emission runs in a
+ * loop instead of growing the stack.
+ */
+class Trampoline {
+ public:
+  using drain_type = void (*)(void*);
+
+  // mark one dispatch level, pending drain is run when the last one exits
+  class Scope {
+   public:
+    Scope() noexcept { ++Local().depth; }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope() {
+      auto& state = Local();
+      if (--state.depth == 0) Run(state);
+    }
+  };
+
+  /**
+   * @brief: Dispatch of object on the calling thread. Object destroyed by
+   * one of its own slot flags every frame of it on the thread, the dispatch
+   * then returns without touching the object, and the list a frame still
+   * reads is handed to the frame and freed when it exits.
+   *
+   * @param: users counted for the lifetime of the frame when set
+   */
+  class Frame {
+   public:
+    explicit Frame(const void* object,
+                   std::atomic_uint32_t* users = nullptr) noexcept
+        : object_(object), users_(users), prev_(Local().frames) {
+      Local().frames = this;
+      if (users_) users_->fetch_add(1, std::memory_order_relaxed);
+    }
+    Frame(const Frame&) = delete;
+    Frame& operator=(const Frame&) = delete;
+
+    ~Frame() {
+      Local().frames = prev_;
+      if (users_) users_->fetch_sub(1, std::memory_order_release);
+      while (orphans_) {
+        auto next = orphans_->next;
+        orphans_->reclaim(orphans_);
+        orphans_ = next;
+      }
+    }
+
+    // guard should be declared after the frame so it is released first
+    template <typename T>
+    T* Protect(HazardDomain::Guard& guard, const std::atomic<T*>& source) {
+      guard_ = &guard;
+      auto list = guard.Protect(source);
+      list_ = list;
+      return list;
+    }
 
-  template <typename L>
-  using is_thread_safe = std::integral_constant<bool, true>;
+    bool IsDestroyed() const noexcept { return destroyed_; }
 
-  template <typename U, typename L>
-  using cow_type =
-      std::conditional_t<is_thread_safe<L>::value, detail::CopyOnWrite<U>, U>;
+   private:
+    friend class Trampoline;
+
+    const void* object_;
+    std::atomic_uint32_t* users_;
+    Frame* prev_;
+    bool destroyed_ = false;
+    HazardDomain::Guard* guard_ = nullptr;
+    const void* list_ = nullptr;
+    HazardDomain::Retired* orphans_ = nullptr;
+  };
 
-  template <typename U, typename L>
-  using cow_copy_type = std::conditional_t<is_thread_safe<L>::value,
-                                           detail::CopyOnWrite<U>, const U&>;
+  static size_t Depth() noexcept { return Local().depth; }
 
-  using slot_type = Slot<Emitted>;
+  /**
+   * @brief: Drain object once the outermost dispatch returns, object is only
+   * queued once
+   */
+  static void Defer(void* object, drain_type drain) {
+    auto& pending = Local().pending;
+    for (const auto& it : pending)
+      if (it.first == object) return;
+    pending.emplace_back(object, drain);
+  }
+
+  // should be called by object being destroyed on this thread
+  static void Cancel(void* object) noexcept {
+    auto& state = Local();
+    auto& pending = state.pending;
+    pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                 [&](const auto& it) {
+                                   return it.first == object;
+                                 }),
+                  pending.end());
+
+    for (auto frame = state.frames; frame; frame = frame->prev_) {
+      if (frame->object_ != object) continue;
+      frame->destroyed_ = true;
+      if (frame->guard_) frame->guard_->Forget();
+    }
+  }
+
+  // frame of this thread counted in users
+  static uint32_t Users(const std::atomic_uint32_t* users) noexcept {
+    uint32_t count = 0;
+    for (auto frame = Local().frames; frame; frame = frame->prev_)
+      if (frame->users_ == users) ++count;
+    return count;
+  }
+
+  /**
+   * @brief: Hand list of the object being destroyed to the outermost frame
+   * of this thread still reading it, so it is freed by free once the frame
+   * exits
+   *
+   * @return: false if no frame reads the list, it can be freed now
+   */
+  static bool Adopt(const void* object, HazardDomain::Retired* list,
+                    void (*free)(HazardDomain::Retired*) noexcept) noexcept {
+    Frame* outermost = nullptr;
+    for (auto frame = Local().frames; frame; frame = frame->prev_)
+      if (frame->object_ == object && frame->list_ == list) outermost = frame;
+    if (!outermost) return false;
+
+    list->reclaim = free;
+    list->next = outermost->orphans_;
+    outermost->orphans_ = list;
+    return true;
+  }
+
+ private:
+  struct State {
+    size_t depth = 0;
+    bool running = false;
+    std::vector<std::pair<void*, drain_type>> pending;
+    Frame* frames = nullptr;
+  };
+
+  static State& Local() noexcept {
+    thread_local State state;
+    return state;
+  }
+
+  // drain run at depth 0 so what it emits is dispatched inline again, drain
+  // deferred meanwhile is picked up by this loop instead of nesting another
+  static void Run(State& state) {
+    if (state.running) return;
+    state.running = true;
+    while (!state.pending.empty()) {
+      auto entry = state.pending.front();
+      state.pending.erase(state.pending.begin());
+      entry.second(entry.first);
+    }
+    state.running = false;
+  }
+};
+
+/**
+ * @return: small index unique to the calling thread, given in the order
+ * thread first asks for it
+ */
+inline size_t ThreadIndex() noexcept {
+  static std::atomic_size_t next{0};
+  thread_local const size_t index =
+      next.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+}  // namespace detail
+
+/**
+ * @brief: Order in which the drainer dispatch event of a sharded Signal
+ */
+enum class ShardOrder : uint8_t {
+  // queue order across every producer, each event takes a ticket from one
+  // shared counter
+  kEmission,
+  // only event queued by the same thread keep their order, producer share
+  // nothing
+  kProducer
+};
+
+/**
+ * @brief: Snapshot of Signal counters, each read without lock
+ */
+struct SignalStats {
+  // binded slot, slot unbinded by its observer, tracked object or BindingId
+  // is not counted even before it is removed
+  size_t slots = 0;
+
+  // slot already unbinded but still in the list, removed together by the
+  // next drain or by the bind that finds enough of them
+  size_t expired = 0;
+
+  // event waiting in queue and the deepest the queue has been
+  size_t queued = 0;
+  size_t high_water = 0;
+
+  // event accepted in queue and taken out of it by a drainer
+  uint64_t emitted = 0;
+  uint64_t drained = 0;
+
+  // thread currently draining the queue
+  size_t drainers = 0;
+
+  // drain deferred to the trampoline past the max depth, and the deepest
+  // dispatch nesting the signal was drained at
+  uint64_t deferred = 0;
+  size_t deepest = 0;
+
+  // replaced slot list kept until no emitter reads it, each keeps its
+  // slot alive
+  size_t retired = 0;
+
+  bool blocked = false;
+};
+
+/**
+ * @brief: Signal dispatching Emitted to binded slot, event is queued and
+ * drained by the emitting thread or the attached EventLoop.
+ *
+ * Signal is meant to be embedded in large number of object: it owns no
+ * mutex, its lock is taken from a shared stripe pool, and nothing is
+ * allocated until the first slot is binded or the first event is queued.
+ * Emission never takes the slot lock, the slot list is read through a
+ * hazard pointer.
+ * sizeof(Signal) stays within kSizeBudget, 144 byte, on 64 bit platform.
+ *
+ * With a Result, slot returns Result and Emit dispatches inline feeding
+ * every result to a combiner that can stop the dispatch. Queued event still
+ * calls every slot and drops the result.
+ */
+template <typename Emitted = void, typename Result = void>
+class Signal : Cleanable, Drainable {
+ protected:
+  using slot_type = slot_base_t<Emitted, Result>;
   using slot_ptr = std::shared_ptr<slot_type>;
-  using slot_container = std::list<slot_ptr>;
+  /**
+   * Slot of a group. Slot is appended to a published array while it has
+   * room: it is constructed before the size is released, and emitter only
+   * reads slot below the size it acquired. Published array never grows or
+   * moves its slot, it is copied instead.
+   */
+  class slot_container {
+   public:
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+    using iterator = slot_ptr*;
+    using const_iterator = const slot_ptr*;
+
+    explicit slot_container(const allocator_type& alloc) : alloc_(alloc) {}
+
+    slot_container(const slot_container& o, const allocator_type& alloc)
+        : alloc_(alloc) {
+      Reserve(o.capacity_);
+      for (const auto& slot : o) push_back(slot_ptr(slot));
+    }
+
+    slot_container(slot_container&& o, const allocator_type& alloc)
+        : alloc_(alloc) {
+      if (alloc_ != o.alloc_) {
+        Reserve(o.capacity_);
+        for (auto& slot : o) push_back(std::move(slot));
+        return;
+      }
+      std::swap(data_, o.data_);
+      std::swap(capacity_, o.capacity_);
+      size_.store(o.size_.exchange(0, std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+    }
+
+    slot_container(const slot_container&) = delete;
+    slot_container& operator=(const slot_container&) = delete;
+
+    ~slot_container() {
+      erase(begin(), end());
+      if (data_)
+        alloc_.resource()->deallocate(data_, capacity_ * sizeof(slot_ptr),
+                                      alignof(slot_ptr));
+    }
+
+    size_t size() const noexcept {
+      return size_.load(std::memory_order_acquire);
+    }
+    size_t capacity() const noexcept { return capacity_; }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size(); }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size(); }
+
+    const slot_ptr& operator[](size_t index) const noexcept {
+      return data_[index];
+    }
+    slot_ptr& back() noexcept { return data_[size() - 1]; }
+
+    // grows when full, which should only happen before it is published
+    void push_back(slot_ptr&& slot) {
+      const auto size = size_.load(std::memory_order_relaxed);
+      if (size == capacity_) Reserve(std::max<size_t>(1, size * 2));
+      new (data_ + size) slot_ptr(std::move(slot));
+      size_.store(size + 1, std::memory_order_release);
+    }
+
+    // should only be called before it is published
+    void erase(iterator first, iterator last) noexcept {
+      auto kept = std::move(last, end(), first);
+      for (auto it = kept; it != end(); ++it) it->~slot_ptr();
+      size_.store(size_t(kept - data_), std::memory_order_release);
+    }
+    void erase(iterator it) noexcept { erase(it, it + 1); }
 
+   private:
+    void Reserve(size_t capacity) {
+      if (capacity <= capacity_) return;
+      auto data = static_cast<slot_ptr*>(alloc_.resource()->allocate(
+          capacity * sizeof(slot_ptr), alignof(slot_ptr)));
+      const auto size = size_.load(std::memory_order_relaxed);
+      for (size_t i = 0; i < size; ++i) {
+        new (data + i) slot_ptr(std::move(data_[i]));
+        data_[i].~slot_ptr();
+      }
+      if (data_)
+        alloc_.resource()->deallocate(data_, capacity_ * sizeof(slot_ptr),
+                                      alignof(slot_ptr));
+      data_ = data;
+      capacity_ = capacity;
+    }
+
+    allocator_type alloc_;
+    slot_ptr* data_ = nullptr;
+    size_t capacity_ = 0;
+    std::atomic_size_t size_{0};
+  };
+
+  // slot is stored oldest first and called newest first
   struct group_type {
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    explicit group_type(const allocator_type& alloc) : list(alloc) {}
+    group_type(const group_type& o, const allocator_type& alloc)
+        : list(o.list, alloc), mask(o.mask), id(o.id) {}
+    group_type(group_type&& o, const allocator_type& alloc)
+        : list(std::move(o.list), alloc), mask(std::move(o.mask)), id(o.id) {}
+
     slot_container list;
+    // live slot of list, shared with older copy of the group until a slot is
+    // removed, so bit past the end of a list is ignored
+    std::shared_ptr<detail::SlotMask> mask;
     int id = 0;
   };
 
-  using list_type = std::list<group_type>;
+  using list_type = std::pmr::list<group_type>;
   using event_type = Event<Emitted>;
-  using event_ptr = std::unique_ptr<event_type>;
   using arg_list = event_type&;
-  cow_type<std::list<group_type>, Lockable> slot_list_;
 
-  std::queue<event_ptr> queue_event_;
-  Lockable slot_mutex_, queue_mutex_;
-  std::atomic_bool block_;
+  // event keeps the resource it is allocated from so it can outlive the
+  // queue it is taken from
+  struct event_delete {
+    std::pmr::memory_resource* resource;
+
+    void operator()(event_type* event) const noexcept {
+      event->~event_type();
+      resource->deallocate(event, sizeof(event_type), alignof(event_type));
+    }
+  };
+
+  using event_ptr = std::unique_ptr<event_type, event_delete>;
+
+  // for object keeping its resource in a resource member
+  struct resource_delete {
+    template <typename T>
+    void operator()(T* object) const noexcept {
+      auto resource = object->resource;
+      object->~T();
+      resource->deallocate(object, sizeof(T), alignof(T));
+    }
+  };
+
+  // events and slots waiting to be called on another loop thread, slot is
+  // only added when the dispatch reached it
+  struct deferred_type {
+    std::shared_ptr<event_type> event;
+    std::pmr::vector<slot_ptr> slots;
+    size_t serial;
+  };
+
+  struct deferred_list {
+    std::vector<std::pair<EventLoop*, std::pmr::vector<deferred_type>>> loops;
+    size_t serial = 0;
+  };
+
+  // every allocation of the signal is made from resource_
+  std::pmr::memory_resource* resource_;
+
+  struct shard_entry {
+    event_ptr event;
+    // order of the event across shard, 0 with ShardOrder::kProducer
+    uint64_t ticket;
+#ifdef EVTSIGSLOT_TRACE
+    uint64_t time;
+#endif
+  };
+
+  // queue of the producer thread mapped to it, on its own cache line
+  struct EVTSIGSLOT_CACHE_ALIGNED shard_type {
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    explicit shard_type(const allocator_type& alloc)
+        : events(alloc), taken(alloc) {}
+
+    std::mutex mutex;
+    std::pmr::vector<shard_entry> events;
+    // swapped with events by the merge, guarded by QueueMutex()
+    std::pmr::vector<shard_entry> taken;
+    std::atomic<uint64_t> emitted{0};
+  };
+
+  // next entry of a shard taken by the merge
+  struct shard_cursor {
+    shard_entry* next;
+    shard_entry* end;
+  };
+
+  struct shard_list {
+    shard_list(std::pmr::memory_resource* r, size_t count, ShardOrder o)
+        : resource(r), shards(count, r), cursors(r), order(o) {}
+
+    std::pmr::memory_resource* resource;
+    // never resized, producer index it without lock
+    std::pmr::vector<shard_type> shards;
+    // guarded by QueueMutex(), keeps its capacity between merge
+    std::pmr::vector<shard_cursor> cursors;
+    ShardOrder order;
+    EVTSIGSLOT_CACHE_ALIGNED std::atomic<uint64_t> ticket{0};
+  };
+
+  /**
+   * Slot list read by emitter, only appended to once published. Writer
+   * binding to a group with room appends in place with SlotMutex() held,
+   * any other change copies the list, publishes the copy and retires the old
+   * list, which is reclaimed once no emitter protects it with a hazard
+   * pointer.
+   */
+  struct snapshot_type : detail::HazardDomain::Retired {
+    explicit snapshot_type(std::pmr::memory_resource* r)
+        : resource(r), list(r) {}
+    snapshot_type(std::pmr::memory_resource* r, const list_type& o)
+        : resource(r), list(o, r) {}
+
+    std::pmr::memory_resource* resource;
+    list_type list;
+  };
+
+  using snapshot_ptr = std::unique_ptr<snapshot_type, resource_delete>;
+
+  // null until the first slot is binded and after UnbindAll
+  std::atomic<snapshot_type*> slot_list_{nullptr};
+
+  /**
+   * State written on every queued event, allocated by the first one on its
+   * own cache line so producer and drainer writing it don't invalidate the
+   * line emitter read the rest of the signal from. Container is guarded by
+   * QueueMutex(), counter is read without lock.
+   */
+  struct EVTSIGSLOT_CACHE_ALIGNED queue_type {
+    explicit queue_type(std::pmr::memory_resource* r)
+        : resource(r), events(r), sequenced(r) {}
+
+    std::pmr::memory_resource* resource;
+    std::queue<event_ptr, std::pmr::deque<event_ptr>> events;
+#ifdef EVTSIGSLOT_TRACE
+    // queue time of each event of events
+    std::queue<uint64_t> time;
+#endif
+    // key of event being dispatched by a drainer, with event of the same key
+    // handed to that drainer
+    std::function<size_t(const event_type&)> sequencer;
+    std::pmr::unordered_map<size_t, std::pmr::deque<event_ptr>> sequenced;
+
+    // emitted and high_water are written with QueueMutex() held, drained is
+    // released after the pop so a reader never sees more drained than
+    // emitted
+    std::atomic<uint64_t> emitted{0}, drained{0};
+    std::atomic_uint32_t high_water{0}, handler{0};
+    // the loop drain sets draining before it clears scheduled
+    std::atomic_bool scheduled{false}, draining{false};
+
+    // set once by SetShards, producer read it without lock
+    std::atomic<shard_list*> shards{nullptr};
+    std::unique_ptr<shard_list, resource_delete> shard_owner;
+  };
+
+  // published with release once, freed with the signal
+  std::atomic<queue_type*> queue_{nullptr};
+
+  // below is read on every emission and rarely written
+  std::atomic<uint64_t> deferred_{0};
+  std::atomic_uint32_t slot_count_{0}, deepest_{0};
+
+  // slot whose tracked object expired, removed together after a drain or
+  // by the bind that sees kCleanThreshold of them
+  std::atomic_uint32_t expired_{0};
+  static constexpr uint32_t kCleanThreshold = 64;
+
+  // replaced slot list not reclaimed yet
+  mutable std::atomic_uint32_t retired_{0};
+
+  inline static uint32_t default_handler_limit_ = 1;
+  uint32_t handler_limit_ = default_handler_limit_;
+
+  inline static uint32_t default_max_depth_ = 64;
+  uint32_t max_depth_ = default_max_depth_;
+
+  std::atomic_bool block_, rate_limited_{false};
+  std::atomic<EventLoop*> event_loop_;
+
+  // allocated by the first BindId, table_ is guarded by SlotMutex()
+  std::shared_ptr<detail::SlotTable> table_;
+  std::atomic<detail::SlotTable*> table_ptr_{nullptr};
+
+  // outlived by timer that refers to this signal, delivery counts itself
+  // in users under the mutex and dispatches without it, the destructor
+  // waits for delivery in flight on another thread
+  struct timer_token_type {
+    explicit timer_token_type(Signal* s) : signal(s) {}
+
+    std::mutex mutex;
+    Signal* signal;
+    std::atomic_uint32_t users{0};
+  };
+
+  std::shared_ptr<timer_token_type> timer_token_;
+
+  class timer_type : public detail::TimerNode {
+   public:
+    timer_type(const std::shared_ptr<timer_token_type>& signal, bool periodic,
+               event_ptr event)
+        : event_(std::move(event)),
+          periodic_(periodic),
+          signal_(signal),
+          target_(signal.get()) {}
+
+    // the slot may destroy or move the signal, so it isn't locked
+    void Deliver(batch_iterator first, batch_iterator last) override {
+      auto token = signal_.lock();
+      if (!token) return;
+
+      std::unique_lock<std::mutex> locker(token->mutex);
+      auto signal = token->signal;
+      if (!signal) return;
+      detail::Trampoline::Frame frame(signal, &token->users);
+      locker.unlock();
+      signal->QueueTimers(first, last);
+    }
+
+    const void* Target() const noexcept override { return target_; }
+
+    event_ptr event_;
+    bool periodic_;
+
+   private:
+    std::weak_ptr<timer_token_type> signal_;
+    const void* target_;
+  };
+
+  class rate_timer_type : public detail::TimerNode {
+   public:
+    explicit rate_timer_type(const std::shared_ptr<timer_token_type>& signal)
+        : signal_(signal) {}
+
+    // pinned like timer_type, the trailing event is dispatched unlocked
+    void Deliver(batch_iterator, batch_iterator) override {
+      auto token = signal_.lock();
+      if (!token) return;
+
+      std::unique_lock<std::mutex> locker(token->mutex);
+      auto signal = token->signal;
+      if (!signal) return;
+      detail::Trampoline::Frame frame(signal, &token->users);
+      locker.unlock();
+      signal->OnRateTimer(this);
+    }
+
+    const void* Target() const noexcept override { return this; }
+
+   private:
+    std::weak_ptr<timer_token_type> signal_;
+  };
+
+  // throttle or debounce state, guarded by QueueMutex()
+  struct rate_limit_type {
+    explicit rate_limit_type(std::pmr::memory_resource* r) : resource(r) {}
+
+    std::pmr::memory_resource* resource;
+    enum Mode { kThrottle, kDebounce } mode;
+    TimerWheel* wheel;
+    TimerWheel::duration interval;
+    bool trailing;
+
+    bool has_last = false, armed = false;
+    TimerWheel::time_point last, deadline;
+    std::optional<event_type> pending;
+    std::shared_ptr<rate_timer_type> timer;
+
+    TimerWheel::time_point Now() const {
+      return wheel ? wheel->Now() : TimerWheel::clock_type::now();
+    }
+  };
 
-  inline static size_t default_handler_limit_ = 1;
-  size_t handler_limit_ = default_handler_limit_;
-  std::atomic_size_t handler_;
+  std::unique_ptr<rate_limit_type, resource_delete> rate_limit_;
+
+  // slot passing the event being dispatched to another signal
+  class forward_slot_type : public slot_type {
+   public:
+    forward_slot_type(Cleanable& c, Signal& target)
+        : slot_type(c), target_(target) {}
+
+    func_ptr GetCallable() override { return get_function_ptr(nullptr); }
+
+    bool HasObject(const void* obj) override { return obj == &target_; }
+
+   protected:
+    // downstream dispatch on its own flags so its Veto doesn't stop this
+    // signal
+    void DoCall(event_type& event) override {
+      auto& flags = static_cast<internal::EmptyEvent&>(event);
+      const auto saved = flags;
+      flags = internal::EmptyEvent();
+      target_.ForwardEvent(event);
+      flags = saved;
+      event.Skip();
+    }
+
+   private:
+    Signal& target_;
+  };
 
   using locker_type = std::scoped_lock<std::mutex>;
 
   static constexpr bool is_emit_void = std::is_same_v<Emitted, void>;
+  static constexpr bool is_result_void = std::is_void_v<Result>;
 
  public:
-  Signal() : block_(false), handler_(0) {}
+  using value_type = Emitted;
+
+  static constexpr size_t kSizeBudget = 144;
+
+  Signal() : Signal(std::pmr::get_default_resource()) {}
+
+  /**
+   * @param: resource every slot, event, list and table of the signal is
+   * allocated from, it should outlive the signal, every Binding and Timer
+   * of the signal and every event it posted to an EventLoop
+   */
+  explicit Signal(std::pmr::memory_resource* resource)
+      : resource_(resource), block_(false), event_loop_(nullptr) {}
   Signal(const Signal&) = delete;
   Signal& operator=(const Signal&) = delete;
 
-  Signal(Signal&& m) : block_(m.block_.load()) {
-    locker_type lock(m.slot_mutex_);
-    handler_.exchange(m.handler_.load());
-    std::swap(slot_list_, m.slot_list_);
+  /**
+   * @brief: Move slot, queued event, pending timer, rate limit, drainer
+   * limit, max depth, loop attachment and Stats counters, no other thread
+   * should use either signal meanwhile. Assignment swaps them.
+   */
+  Signal(Signal&& m)
+      : resource_(m.resource_), block_(m.block_.load()), event_loop_(nullptr) {
+    locker_type lock(m.SlotMutex());
+    slot_list_.store(m.slot_list_.exchange(nullptr));
+    slot_count_.store(m.slot_count_.exchange(0));
+    expired_.store(m.expired_.exchange(0));
+    deferred_.store(m.deferred_.exchange(0));
+    deepest_.store(m.deepest_.exchange(0));
+    std::swap(table_, m.table_);
+    table_ptr_.store(m.table_ptr_.exchange(nullptr));
+    SwapQueue(m);
   }
 
-  ~Signal() { UnbindAll(); }
+  /**
+   * @brief: Queued event is dropped, not dispatched. Waits for the attached
+   * loop draining the signal on another thread. Can be called by a slot of
+   * the signal, its dispatch then returns once the slot does.
+   */
+  ~Signal() {
+    ResetTimerToken();
+    if (auto loop = event_loop_.exchange(nullptr)) CancelDrain(*loop);
+    detail::Trampoline::Cancel(this);
+    // no other thread can read the list anymore, it is freed without a scan
+    if (auto list = DetachSlots()) FreeSlots(list);
+    if (retired_.load()) {
+      auto list = detail::HazardDomain::Instance().Take(this);
+      while (list) {
+        auto next = list->next;
+        FreeSlots(static_cast<snapshot_type*>(list));
+        retired_.fetch_sub(1, std::memory_order_relaxed);
+        list = next;
+      }
+      // list unlinked by another thread is still being reclaimed
+      while (retired_.load(std::memory_order_acquire))
+        std::this_thread::yield();
+    }
+    if (auto queue = queue_.load()) resource_delete()(queue);
+  }
 
   Signal& operator=(Signal&& m) {
-    locker_type lock(slot_mutex_, m.slot_mutex_);
+    // both signal may share a stripe
+    std::unique_lock<std::mutex> lock(SlotMutex(), std::defer_lock),
+        other(m.SlotMutex(), std::defer_lock);
+    if (&SlotMutex() == &m.SlotMutex())
+      lock.lock();
+    else
+      std::lock(lock, other);
 
-    handler_.exchange(m.handler_.load());
-    swap(slot_list_, m.slot_list_);
+    std::swap(resource_, m.resource_);
+    slot_list_.store(m.slot_list_.exchange(slot_list_.load()));
+    slot_count_.store(m.slot_count_.exchange(slot_count_.load()));
+    expired_.store(m.expired_.exchange(expired_.load()));
+    deferred_.store(m.deferred_.exchange(deferred_.load()));
+    deepest_.store(m.deepest_.exchange(deepest_.load()));
+    std::swap(table_, m.table_);
+    table_ptr_.store(m.table_ptr_.exchange(table_ptr_.load()));
     block_.store(m.block_.exchange(block_.load()));
+    SwapQueue(m);
+    return *this;
   }
 
   /**
@@ -117,13 +802,106 @@ class Signal : Cleanable {
   template <typename... T>
   emit_void_return<T...> Queue(T&&... val) {
     if (block_) return;
+    if (rate_limited_.load(std::memory_order_relaxed) &&
+        !PassRateLimit(std::forward<T>(val)...))
+      return;
 
-    {
-      locker_type queue_locker(queue_mutex_);
-      queue_event_.emplace(
-          std::make_unique<event_type>(std::forward<T>(val)...));
+    auto event = MakeEvent(std::forward<T>(val)...);
+    if (!PushShard(event)) {
+      locker_type queue_locker(QueueMutex());
+      Enqueue(std::move(event));
     }
 
+    DrainOrSchedule();
+  }
+
+  /**
+   * @brief: Queue event once delay has passed on wheel
+   *
+   * @param: wheel TimerWheel that expire the event
+   * @param: delay time before event is queued
+   *
+   * @return: Timer that can cancel the event
+   */
+  template <typename... T>
+  std::enable_if_t<std::is_constructible_v<Emitted, T...> || is_emit_void,
+                   Timer>
+  QueueAfter(TimerWheel& wheel, TimerWheel::duration delay, T&&... val) {
+    return wheel.Add(MakeTimer(false, std::forward<T>(val)...), delay);
+  }
+
+  /**
+   * @brief: Queue a copy of the event every period on wheel until the
+   * returned Timer is cancelled
+   */
+  template <typename... T>
+  std::enable_if_t<std::is_constructible_v<Emitted, T...> || is_emit_void,
+                   Timer>
+  QueueEvery(TimerWheel& wheel, TimerWheel::duration period, T&&... val) {
+    static_assert(std::is_copy_constructible_v<event_type>,
+                  "Emitted must be copyable to be queued periodically");
+    return wheel.Add(MakeTimer(true, std::forward<T>(val)...), period, period);
+  }
+
+  /**
+   * @brief: Queue at most one event per interval, other emission is dropped
+   * before any event is allocated
+   */
+  void Throttle(TimerWheel::duration interval) {
+    SetRateLimit(rate_limit_type::kThrottle, nullptr, interval, false);
+  }
+
+  /**
+   * @brief: Queue at most one event per interval measured by wheel time,
+   * when trailing is set the last dropped value is queued at the end of the
+   * interval
+   *
+   * @param: wheel TimerWheel that must outlive the throttle
+   */
+  void Throttle(TimerWheel& wheel, TimerWheel::duration interval,
+                bool trailing = true) {
+    SetRateLimit(rate_limit_type::kThrottle, &wheel, interval, trailing);
+  }
+
+  /**
+   * @brief: Only queue the last emitted value once no emission happened for
+   * interval measured by wheel time
+   *
+   * @param: wheel TimerWheel that must outlive the debounce
+   */
+  void Debounce(TimerWheel& wheel, TimerWheel::duration interval) {
+    SetRateLimit(rate_limit_type::kDebounce, &wheel, interval, true);
+  }
+
+  /**
+   * @brief: Remove Throttle or Debounce, pending trailing value is dropped
+   */
+  void ResetRateLimit() {
+    locker_type queue_locker(QueueMutex());
+    rate_limit_.reset();
+    rate_limited_.store(false);
+  }
+
+  /**
+   * @brief: Let loop drain this signal, Queue will only schedule the signal
+   * on the loop instead of draining it on the emitting thread
+   *
+   * @param: loop EventLoop that must outlive the attachment
+   */
+  void Attach(EventLoop& loop) {
+    Detach();
+    event_loop_.store(&loop);
+  }
+
+  /**
+   * @brief: Stop draining on the attached loop, event already queued is
+   * drained on the calling thread once the loop drain in flight returns
+   */
+  void Detach() {
+    auto loop = event_loop_.exchange(nullptr);
+    if (!loop) return;
+
+    CancelDrain(*loop);
     ProcessEvent();
   }
 
@@ -133,15 +911,56 @@ class Signal : Cleanable {
   }
 
   void PostEvent(event_type& event) {
-    cow_copy_type<list_type, Lockable> ref = SlotReference();
+    detail::Trampoline::Scope scope;
+    deferred_list deferred;
+    DoPostEvent(event, deferred);
+    PostDeferred(deferred);
+  }
 
-    for (const auto& group : detail::CowRead(ref)) {
-      for (const auto& slot : group.list) {
-        event.Skip(false);
-        slot->operator()(event);
-        if (!event.IsSkipped()) break;
-      }
+  /**
+   * @brief: Dispatch on the calling thread without queueing, newest slot
+   * first, and pass each slot result to combiner until it returns false.
+   * Blocked slot is not called and slot bound to another loop thread is
+   * skipped since its result can't come back. Slot can also stop the
+   * dispatch with Event::Veto.
+   *
+   * @param: combiner like FirstNonEmpty, AnyOf, AllOf, Sum or Collect
+   * @return: combiner holding the combined result
+   */
+  template <typename Combiner, typename... T>
+  std::enable_if_t<!is_result_void && (std::is_constructible_v<Emitted, T...> ||
+                                       is_emit_void),
+                   Combiner>
+  Emit(Combiner combiner, T&&... val) {
+    if (block_) return combiner;
+
+    detail::Trampoline::Scope scope;
+    event_type event(std::forward<T>(val)...);
+    detail::Trampoline::Frame frame(this);
+    detail::HazardDomain::Guard guard;
+    auto list = frame.Protect(guard, slot_list_);
+    if (!list) return combiner;
+
+    bool more = true;
+    for (const auto& group : list->list) {
+      group.mask->ReverseForEach([&](size_t index) {
+        if (index >= group.list.size()) return true;
+
+        const auto& slot = group.list[index];
+        if (slot->loop_ && !slot->loop_->IsInLoopThread()) return true;
+
+        EVTSIGSLOT_TRACE_SPAN(
+            kSlot, static_cast<const detail::SlotState*>(slot.get()), this);
+        EVTSIGSLOT_PROBE2(slot__entry, this, slot.get());
+        auto result = slot->Invoke(event);
+        EVTSIGSLOT_PROBE2(slot__return, this, slot.get());
+        if (result) more = combiner(std::move(*result));
+        more = more && event.IsAllowed() && !frame.IsDestroyed();
+        return more;
+      });
+      if (!more) break;
     }
+    return combiner;
   }
 
   template <typename... T>
@@ -149,38 +968,166 @@ class Signal : Cleanable {
     Queue(std::forward<T>(val)...);
   }
 
+  /**
+   * @brief: Drain queued event on the calling thread. When the thread is
+   * already dispatching MaxDepth level deep, the drain is deferred until the
+   * outermost dispatch of the thread returns.
+   *
+   * With more than one drainer allowed, thread calling ProcessEvent at the
+   * same time each dispatch a different event, event with the same sequencer
+   * key is still dispatched one at a time in queue order.
+   *
+   * @param: force drain even when the drainer limit or depth is reached
+   */
   void ProcessEvent(bool force = false) {
+    const auto depth = detail::Trampoline::Depth();
+    if (!force && depth >= max_depth_) {
+      deferred_.fetch_add(1, std::memory_order_relaxed);
+      detail::Trampoline::Defer(this, [](void* signal) {
+        static_cast<Signal*>(signal)->ProcessEvent();
+      });
+      return;
+    }
+
+    // nothing was ever queued
+    auto queue = queue_.load(std::memory_order_acquire);
+    if (!queue) return;
+
+    // declared first so deferred drain runs after this one released handler
+    detail::Trampoline::Scope scope;
     {
-      locker_type locker(queue_mutex_);
-      if (!force && handler_.load() < handler_limit_)
-        handler_.store(handler_ + 1);
-      else
-        return;
+      locker_type locker(QueueMutex());
+      if (!force) {
+        if (queue->handler.load(std::memory_order_relaxed) >= handler_limit_)
+          return;
+        queue->handler.fetch_add(1, std::memory_order_relaxed);
+      }
+      EVTSIGSLOT_PROBE2(drain__start, this, queue->events.size());
     }
+    if (depth + 1 > deepest_.load(std::memory_order_relaxed))
+      deepest_.store(depth + 1, std::memory_order_relaxed);
 
+    // handler is released with QueueMutex() held once the queue is seen
+    // empty, so an event queued after that finds a free drainer, the guard
+    // only release it when a slot throws
     struct handler_decrement {
-      std::atomic_size_t& atom_;
+      std::atomic_uint32_t& atom_;
       bool decrement_;
-      handler_decrement(std::atomic_size_t& atom, bool should_decrement)
+      handler_decrement(std::atomic_uint32_t& atom, bool should_decrement)
           : atom_(atom), decrement_(should_decrement) {}
-      ~handler_decrement() { atom_.store(atom_.load() - 1); }
+      ~handler_decrement() {
+        if (decrement_) atom_.fetch_sub(1, std::memory_order_relaxed);
+      }
     };
 
-    handler_decrement decrement(handler_, !force);
+    handler_decrement decrement(queue->handler, !force);
+    deferred_list deferred;
+    EVTSIGSLOT_TRACE_SPAN(kDrain, this, nullptr);
+    [[maybe_unused]] size_t drained = 0;
+    std::optional<size_t> key;
 
     while (true) {
-      std::unique_ptr<Event<Emitted>> event;
+      event_ptr event;
       {
-        locker_type queue_locker(queue_mutex_);
-        if (queue_event_.empty()) break;
-        event = std::move(queue_event_.front());
-        queue_event_.pop();
+        locker_type queue_locker(QueueMutex());
+        event = NextEvent(key);
+        if (!event) {
+          if (decrement.decrement_)
+            queue->handler.fetch_sub(1, std::memory_order_relaxed);
+          decrement.decrement_ = false;
+          break;
+        }
+        queue->drained.fetch_add(1, std::memory_order_release);
+      }
+      if (!DoPostEvent(*event, deferred)) {
+        // destroyed by the slot, handler went away with the queue
+        decrement.decrement_ = false;
+        PostDeferred(deferred);
+        return;
       }
-      PostEvent(*event);
+      ++drained;
     }
+    EVTSIGSLOT_PROBE2(drain__done, this, drained);
+
+    PostDeferred(deferred);
+    CleanExpired();
   }
+
+  /**
+   * @brief: Number of thread allowed to drain the queue at the same time, 1
+   * by default so every event is dispatched in queue order
+   */
+  void SetDrainers(size_t drainers) {
+    locker_type queue_locker(QueueMutex());
+    handler_limit_ = uint32_t(std::clamp<size_t>(drainers, 1, UINT32_MAX));
+  }
+
+  /**
+   * @brief: Keep event with the same key in queue order when more than one
+   * thread drains the queue. An event whose key is being dispatched by
+   * another drainer is handed to it and dispatched after its current event.
+   * A constant key gives total order.
+   *
+   * @param: key callable returning size_t for const Emitted&, called with
+   * the queue locked so it should not emit
+   */
+  template <typename Key, typename E = Emitted,
+            typename = std::enable_if_t<!std::is_void_v<E>>>
+  void SetSequencer(Key&& key) {
+    locker_type queue_locker(QueueMutex());
+    QueueState().sequencer = [key = std::forward<Key>(key)](
+                                 const event_type& event) {
+      return static_cast<size_t>(std::invoke(key, event.Get()));
+    };
+  }
+
+  void ResetSequencer() {
+    locker_type queue_locker(QueueMutex());
+    if (auto queue = queue_.load()) queue->sequencer = nullptr;
+  }
+
+  /**
+   * @brief: Let Queue append to one of shards queue, picked by the emitting
+   * thread and locked on its own, instead of the signal queue. The drainer
+   * merges every shard into the signal queue once it is empty, so producer
+   * thread only contend with the drainer and producer sharing their shard.
+   * Pays off when the signal is drained by an EventLoop, an emitting thread
+   * draining inline still takes the queue lock. Event queued by a timer or
+   * a rate limit goes to the signal queue directly.
+   *
+   * Should be called before the signal is emitted from more than one thread,
+   * the shard count can't be changed afterward.
+   *
+   * @param: shards number of shard, 1 at least
+   * @param: order kProducer drops the shared ticket and only keeps order of
+   * event queued by the same thread
+   * @return: false if the signal is already sharded
+   */
+  bool SetShards(size_t shards, ShardOrder order = ShardOrder::kEmission) {
+    auto list = AllocateUnique<shard_list>(std::max<size_t>(shards, 1), order);
+
+    locker_type queue_locker(QueueMutex());
+    auto& queue = QueueState();
+    if (queue.shard_owner) return false;
+    queue.shards.store(list.get(), std::memory_order_release);
+    queue.shard_owner = std::move(list);
+    return true;
+  }
+
+  /**
+   * @brief: Dispatch nesting of the thread, across every signal, past which
+   * draining this signal is deferred. Should be set before emission.
+   *
+   * @param: depth 1 defers every drain nested in another dispatch
+   */
+  void SetMaxDepth(size_t depth) noexcept {
+    max_depth_ = uint32_t(std::clamp<size_t>(depth, 1, UINT32_MAX));
+  }
+  size_t MaxDepth() const noexcept { return max_depth_; }
+
   template <typename... Caller>
-  using slot_traits_def = slot_traits<trait::typelist<Emitted>, Caller...>;
+  using slot_traits_def =
+      slot_traits<trait::typelist<Emitted, Result>, Caller...>;
 
   template <typename... Caller>
   static constexpr bool is_callable_v = slot_traits_def<Caller...>::value;
@@ -190,46 +1137,162 @@ class Signal : Cleanable {
 
   template <typename Callable, typename Class>
   std::enable_if_t<is_callable_v<Callable, Class>, Binding> Bind(
-      Callable&& callable, Class&& class_ptr) {
-    auto slot = std::make_shared<slot_caller_type<Callable, Class>>(
+      Callable&& callable, Class&& class_ptr) {
+    return BindSlot(Allocate<slot_caller_type<Callable, Class>>(
+        static_cast<Cleanable&>(*this), std::forward<Callable>(callable),
+        std::forward<Class>(class_ptr)));
+  }
+
+  template <typename Callable>
+  std::enable_if_t<is_callable_v<Callable>, Binding> Bind(Callable&& callable) {
+    return BindSlot(Allocate<slot_caller_type<Callable>>(
+        static_cast<Cleanable&>(*this), std::forward<Callable>(callable)));
+  }
+
+  /**
+   * @brief: Bind slot like Bind and return a BindingId instead of Binding.
+   * Operation on the id only read the signal slot table without touching any
+   * reference count, the signal must outlive every use of the id.
+   */
+  template <typename Callable, typename... Class>
+  std::enable_if_t<is_callable_v<Callable, Class...>, BindingId> BindId(
+      Callable&& callable, Class&&... class_ptr) {
+    using entry_type =
+        detail::SlotEntry<slot_caller_type<Callable, Class...>>;
+
+    auto slot = Allocate<entry_type>(
+        Table(), static_cast<Cleanable&>(*this),
+        std::forward<Callable>(callable), std::forward<Class>(class_ptr)...);
+    auto id = slot->Id();
+    AddSlot(std::move(slot));
+    return id;
+  }
+
+  bool IsBinded(BindingId id) const noexcept {
+    auto table = table_ptr_.load(std::memory_order_acquire);
+    return table && table->IsBinded(id);
+  }
+
+  bool IsBlocked(BindingId id) const noexcept {
+    auto table = table_ptr_.load(std::memory_order_acquire);
+    return table && table->IsBlocked(id);
+  }
+
+  /**
+   * @return: false if id is no longer binded
+   */
+  bool Block(BindingId id) noexcept {
+    auto table = table_ptr_.load(std::memory_order_acquire);
+    return table && table->SetBlocked(id, true);
+  }
+
+  bool Unblock(BindingId id) noexcept {
+    auto table = table_ptr_.load(std::memory_order_acquire);
+    return table && table->SetBlocked(id, false);
+  }
+
+  /**
+   * @brief: Unbind slot without scanning the slot list, it is removed with
+   * other unbinded slot after the next drain
+   */
+  bool Unbind(BindingId id) noexcept {
+    auto table = table_ptr_.load(std::memory_order_acquire);
+    if (!table || !table->Unbind(id)) return false;
+
+    expired_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief: Bind slot that is only called on the loop thread, event emitted
+   * from other thread is copied and posted to the loop once per drain.
+   *
+   * Whether the slot gets an event is decided when the dispatch reaches it,
+   * like any slot: it is not delivered once an inline slot stopped the
+   * group or vetoed before it. The slot itself runs later, so its Skip and
+   * Veto stop nothing, not even other slot of the same loop.
+   *
+   * @param: loop target EventLoop, must outlive the binding
+   */
+  template <typename Callable, typename Class>
+  std::enable_if_t<is_callable_v<Callable, Class>, Binding> Bind(
+      EventLoop& loop, Callable&& callable, Class&& class_ptr) {
+    static_assert(std::is_copy_constructible_v<event_type>,
+                  "Emitted must be copyable to be sent to EventLoop");
+    auto slot = Allocate<slot_caller_type<Callable, Class>>(
         static_cast<Cleanable&>(*this), std::forward<Callable>(callable),
         std::forward<Class>(class_ptr));
-    Binding bind(slot);
-    AddSlot(std::move(slot));
-    return bind;
+    slot->loop_ = &loop;
+    return BindSlot(std::move(slot));
   }
 
   template <typename Callable>
-  std::enable_if_t<is_callable_v<Callable>, Binding> Bind(Callable&& callable) {
-    auto slot = std::make_shared<slot_caller_type<Callable>>(
+  std::enable_if_t<is_callable_v<Callable>, Binding> Bind(EventLoop& loop,
+                                                          Callable&& callable) {
+    static_assert(std::is_copy_constructible_v<event_type>,
+                  "Emitted must be copyable to be sent to EventLoop");
+    auto slot = Allocate<slot_caller_type<Callable>>(
         static_cast<Cleanable&>(*this), std::forward<Callable>(callable));
-    Binding bind(slot);
-    AddSlot(std::move(slot));
-    return bind;
+    slot->loop_ = &loop;
+    return BindSlot(std::move(slot));
+  }
+
+  /**
+   * @brief: Bind slot into group, group is dispatched in the order its first
+   * slot was binded and Bind put slot in group 0. Slot that doesn't skip the
+   * event only ends its group, Event::Veto ends every group.
+   */
+  template <typename Callable, typename... Class>
+  std::enable_if_t<is_callable_v<Callable, Class...>, Binding> BindGroup(
+      int group, Callable&& callable, Class&&... class_ptr) {
+    auto slot = Allocate<slot_caller_type<Callable, Class...>>(
+        static_cast<Cleanable&>(*this), std::forward<Callable>(callable),
+        std::forward<Class>(class_ptr)...);
+    slot->group_id_ = group;
+    return BindSlot(std::move(slot));
+  }
+
+  /**
+   * @brief: Dispatch every event of this signal to the slot of downstream
+   * without allocating a new event, slot of downstream see the same event
+   * object. Downstream that is attached to an EventLoop or rate limited get a
+   * copy queued instead, so Emitted must be copyable even if downstream is
+   * attached later.
+   *
+   * @param: downstream Signal that must outlive the binding, it can be
+   * unbinded with Unbind(&downstream)
+   */
+  Binding Forward(Signal& downstream) {
+    static_assert(std::is_copy_constructible_v<event_type>,
+                  "Emitted must be copyable to be forwarded");
+    return BindSlot(Allocate<forward_slot_type>(
+        static_cast<Cleanable&>(*this), downstream));
+  }
+
+  /**
+   * @brief: Start a Pipeline that only pass value for which predicate return
+   * true, stages are fused into a single slot on Bind
+   *
+   * @code
+   * sig.Filter(is_valid).Map(to_string).Bind(print);
+   * @endcode
+   */
+  template <typename Predicate>
+  auto Filter(Predicate&& predicate) {
+    static_assert(!is_emit_void, "Pipeline need an emitted value");
+    return Pipeline<Signal, detail::pipeline_identity>(*this, {})
+        .Filter(std::forward<Predicate>(predicate));
   }
 
-  // template <typename Callable, typename Class>
-  // std::enable_if_t<is_callable_v<Callable, Class> &&
-  // !trait::is_observer_v<Class> &&
-  // !trait::is_weak_ptr_compatible_v<Class>,
-  // Binding>
-  // Bind(Callable&& callable, Class&& class_ptr) {
-  // auto slot = MakeSlot<Callable, Class, Emitted>(
-  // *this, std::forward<Callable>(callable),
-  // std::forward<Class>(class_ptr));
-  // Binding bind(slot);
-  // AddSlot(std::move(slot));
-  // return bind;
-  // }
-  //
-  // template <typename Callable>
-  // std::enable_if_t<is_callable_v<Callable>, Binding> Bind(Callable&&
-  // callable) { auto slot = MakeSlot<Callable, Emitted>(*this,
-  // std::forward<Callable>(callable));
-  // Binding bind(slot);
-  // AddSlot(std::move(slot));
-  // return bind;
-  // }
+  /**
+   * @brief: Start a Pipeline that pass the value returned by function
+   */
+  template <typename Function>
+  auto Map(Function&& function) {
+    static_assert(!is_emit_void, "Pipeline need an emitted value");
+    return Pipeline<Signal, detail::pipeline_identity>(*this, {})
+        .Map(std::forward<Function>(function));
+  }
 
   template <typename... Args>
   ScopedBinding BindScoped(Args&&... args) {
@@ -263,111 +1326,877 @@ class Signal : Cleanable {
   std::enable_if_t<is_callable_v<Callable, Object> || trait::is_pmf_v<Callable>,
                    size_t>
   Unbind(const Callable& callable, const Object& obj) {
+    auto obj_ptr = get_object_ptr(obj);
     return DoUnbindIf([&](const auto& it) {
-      return it->HasObject(obj) && it->HasCallable(callable);
+      return it->HasObject(obj_ptr) && it->HasCallable(callable);
     });
   }
 
   /**
    * Unbind all slot binded to the object
    *
-   * @param: class_ptr obj pointer
+   * @param: class_ptr obj pointer, shared_ptr or weak_ptr
    *
    * @return: Unbinded slot
    */
   template <typename Class>
-  std::enable_if_t<!is_callable_v<Class> && trait::is_pointer_v<Class> &&
-                       !trait::is_pmf_v<Class>,
+  std::enable_if_t<!is_callable_v<Class> && !trait::is_pmf_v<Class> &&
+                       (trait::is_pointer_v<Class> ||
+                        trait::is_weak_ptr_compatible_v<Class>),
                    size_t>
   Unbind(const Class& class_ptr) {
+    auto obj_ptr = get_object_ptr(class_ptr);
     auto ret =
-        DoUnbindIf([&](const auto& it) { return it->HasObject(class_ptr); });
+        DoUnbindIf([&](const auto& it) { return it->HasObject(obj_ptr); });
     return ret;
   }
 
-  void UnbindAll() {
-    locker_type locker(slot_mutex_);
-    detail::CowWrite(slot_list_).clear();
-  }
+  void UnbindAll() { RetireSlots(DetachSlots()); }
 
   void Block() noexcept { block_.store(true); }
   void Unblock() noexcept { block_.store(false); }
 
   size_t CountSlot() noexcept {
-    cow_copy_type<list_type, Lockable> ref = SlotReference();
+    detail::HazardDomain::Guard guard;
+    auto list = guard.Protect(slot_list_);
+    if (!list) return 0;
+
     size_t count = 0;
-    for (const auto& group : detail::CowRead(ref)) {
-      count += group.list.size();
+    // slot unbinded by its observer or tracked object is removed later
+    for (const auto& group : list->list) {
+      count += std::count_if(group.list.begin(), group.list.end(),
+                             [](const auto& it) { return it->IsBinded(); });
     }
     return count;
   }
 
-  size_t CountQueue() noexcept { return queue_event_.size(); }
+  size_t CountQueue() const noexcept { return Stats().queued; }
+
+  std::pmr::memory_resource* Resource() const noexcept { return resource_; }
+
+  /**
+   * @brief: Counters kept up to date on every path with relaxed atomic,
+   * reading them never takes a lock
+   */
+  SignalStats Stats() const noexcept {
+    SignalStats stats;
+    if (auto queue = queue_.load(std::memory_order_acquire)) {
+      stats.drained = queue->drained.load(std::memory_order_acquire);
+      stats.emitted = queue->emitted.load(std::memory_order_relaxed);
+      if (auto list = queue->shards.load(std::memory_order_acquire))
+        for (const auto& shard : list->shards)
+          stats.emitted += shard.emitted.load(std::memory_order_relaxed);
+      stats.queued = size_t(stats.emitted - stats.drained);
+      stats.high_water =
+          std::max<size_t>(queue->high_water.load(std::memory_order_relaxed),
+                           stats.queued);
+      stats.drainers = queue->handler.load(std::memory_order_relaxed);
+    }
+
+    const size_t slots = slot_count_.load(std::memory_order_relaxed);
+    const size_t expired = expired_.load(std::memory_order_relaxed);
+    stats.slots = slots > expired ? slots - expired : 0;
+    stats.expired = slots - stats.slots;
+
+    stats.retired = retired_.load(std::memory_order_relaxed);
+    stats.deferred = deferred_.load(std::memory_order_relaxed);
+    stats.deepest = deepest_.load(std::memory_order_relaxed);
+    stats.blocked = block_.load(std::memory_order_relaxed);
+    return stats;
+  }
 
  private:
-  inline cow_copy_type<list_type, Lockable> SlotReference() {
-    locker_type locker(slot_mutex_);
-    return slot_list_;
+  // lock of the slot list and of the queue, taken from the stripe pool so
+  // the signal doesn't own a mutex
+  std::mutex& SlotMutex() const noexcept {
+    return detail::MutexStripe::For(this, 0);
+  }
+
+  std::mutex& QueueMutex() const noexcept {
+    return detail::MutexStripe::For(this, 1);
+  }
+
+  // should be called with QueueMutex() held
+  queue_type& QueueState() {
+    auto queue = queue_.load(std::memory_order_relaxed);
+    if (!queue) {
+      queue = Construct<queue_type>(resource_);
+      queue_.store(queue, std::memory_order_release);
+    }
+    return *queue;
+  }
+
+  template <typename T, typename... Args>
+  T* Construct(Args&&... args) const {
+    void* mem = resource_->allocate(sizeof(T), alignof(T));
+    try {
+      return new (mem) T(std::forward<Args>(args)...);
+    } catch (...) {
+      resource_->deallocate(mem, sizeof(T), alignof(T));
+      throw;
+    }
+  }
+
+  template <typename... T>
+  event_ptr MakeEvent(T&&... val) const {
+    return event_ptr(Construct<event_type>(std::forward<T>(val)...),
+                     event_delete{resource_});
+  }
+
+  template <typename T, typename... Args>
+  std::shared_ptr<T> Allocate(Args&&... args) const {
+    return std::allocate_shared<T>(
+        std::pmr::polymorphic_allocator<T>(resource_),
+        std::forward<Args>(args)...);
+  }
+
+  template <typename T, typename... Args>
+  std::unique_ptr<T, resource_delete> AllocateUnique(Args&&... args) const {
+    return std::unique_ptr<T, resource_delete>(
+        Construct<T>(resource_, std::forward<Args>(args)...));
+  }
+
+  // should be called with SlotMutex() held, the copy is only seen by
+  // emitter once published
+  snapshot_ptr CopySlots() const {
+    auto list = slot_list_.load(std::memory_order_relaxed);
+    return list ? AllocateUnique<snapshot_type>(std::as_const(list->list))
+                : AllocateUnique<snapshot_type>();
+  }
+
+  // should be called with SlotMutex() held, the replaced list should be
+  // retired once the lock is released
+  snapshot_type* PublishSlots(snapshot_ptr&& list) {
+    return slot_list_.exchange(list.release(), std::memory_order_seq_cst);
+  }
+
+  // unpublish the list and detach every slot, the list should be retired
+  snapshot_type* DetachSlots() {
+    snapshot_type* old;
+    {
+      locker_type locker(SlotMutex());
+      old = PublishSlots(nullptr);
+      slot_count_.store(0, std::memory_order_relaxed);
+    }
+    if (!old) return nullptr;
+
+    // slot may still be referenced by a pending EventLoop task
+    for (auto& group : old->list)
+      for (auto& slot : group.list) {
+        EVTSIGSLOT_PROBE2(unbind, this, slot.get());
+        slot->Detach();
+      }
+    return old;
+  }
+
+  // reclaim may destroy slot, so it runs without SlotMutex()
+  void RetireSlots(snapshot_type* list) {
+    if (!list) return;
+    retired_.fetch_add(1, std::memory_order_relaxed);
+    detail::HazardDomain::Instance().Retire(list, &ReclaimSlots, this);
+  }
+
+  // list still read by a dispatch of this thread is freed when it returns
+  void FreeSlots(snapshot_type* list) noexcept {
+    if (!detail::Trampoline::Adopt(this, list, &DeleteSlots))
+      DeleteSlots(list);
+  }
+
+  static void DeleteSlots(detail::HazardDomain::Retired* retired) noexcept {
+    resource_delete()(static_cast<snapshot_type*>(retired));
+  }
+
+  // the decrement is the last access to the signal, the destructor waits
+  // for it
+  static void ReclaimSlots(detail::HazardDomain::Retired* retired) noexcept {
+    auto list = static_cast<snapshot_type*>(retired);
+    auto owner = static_cast<const Signal*>(list->owner);
+    resource_delete()(list);
+    owner->retired_.fetch_sub(1, std::memory_order_release);
+  }
+
+  void ForwardEvent(event_type& event) {
+    if (block_) return;
+
+    // queued past the max depth so the trampoline dispatch it
+    if (event_loop_.load() || rate_limited_.load(std::memory_order_relaxed) ||
+        detail::Trampoline::Depth() >= max_depth_) {
+      if constexpr (is_emit_void)
+        Queue();
+      else
+        Queue(event.Get());
+      return;
+    }
+
+    PostEvent(event);
+  }
+
+  void DrainOrSchedule() {
+    if (auto loop = event_loop_.load()) {
+      // queue is allocated unless nothing was ever queued
+      // scheduled is only written once per drain, not on every emission
+      auto queue = queue_.load(std::memory_order_acquire);
+      if (queue && !queue->scheduled.load(std::memory_order_relaxed) &&
+          !queue->scheduled.exchange(true))
+        loop->Schedule(this);
+      return;
+    }
+
+    ProcessEvent();
+  }
+
+  // remove the signal from the loop it was attached to, a drain in flight
+  // on another thread is waited for
+  void CancelDrain(EventLoop& loop) {
+    auto queue = queue_.load(std::memory_order_acquire);
+    if (!queue) return;
+    if (queue->scheduled.exchange(false) || queue->draining.load())
+      loop.Cancel(this);
+  }
+
+  // should be called with QueueMutex() held
+  const std::shared_ptr<timer_token_type>& TimerToken() {
+    if (!timer_token_) timer_token_ = Allocate<timer_token_type>(this);
+    return timer_token_;
+  }
+
+  // wait for timer delivery in flight, later delivery finds no signal.
+  // Delivery of this thread is the one calling, it isn't waited for.
+  void ResetTimerToken() {
+    if (!timer_token_) return;
+    {
+      locker_type locker(timer_token_->mutex);
+      timer_token_->signal = nullptr;
+    }
+    auto& users = timer_token_->users;
+    const auto own = detail::Trampoline::Users(&users);
+    while (users.load(std::memory_order_acquire) > own)
+      std::this_thread::yield();
+    timer_token_.reset();
+  }
+
+  // should be called when no other thread uses either signal, the loop
+  // holds the signal address so scheduled drain is scheduled again
+  void SwapQueue(Signal& m) {
+    auto unschedule = [](Signal& signal) {
+      auto loop = signal.event_loop_.load();
+      auto queue = signal.queue_.load();
+      if (!loop || !queue || !queue->scheduled.load()) return false;
+      loop->Cancel(&signal);
+      return true;
+    };
+    const bool scheduled = unschedule(*this), other = unschedule(m);
+
+    queue_.store(m.queue_.exchange(queue_.load()));
+    event_loop_.store(m.event_loop_.exchange(event_loop_.load()));
+    rate_limited_.store(m.rate_limited_.exchange(rate_limited_.load()));
+    std::swap(rate_limit_, m.rate_limit_);
+    std::swap(handler_limit_, m.handler_limit_);
+    std::swap(max_depth_, m.max_depth_);
+
+    std::swap(timer_token_, m.timer_token_);
+    for (auto signal : {this, &m}) {
+      if (!signal->timer_token_) continue;
+      locker_type locker(signal->timer_token_->mutex);
+      signal->timer_token_->signal = signal;
+    }
+
+    if (other) event_loop_.load()->Schedule(this);
+    if (scheduled) m.event_loop_.load()->Schedule(&m);
+  }
+
+  template <typename... T>
+  std::shared_ptr<timer_type> MakeTimer(bool periodic, T&&... val) {
+    std::shared_ptr<timer_token_type> token;
+    {
+      locker_type queue_locker(QueueMutex());
+      token = TimerToken();
+    }
+    return Allocate<timer_type>(token, periodic,
+                                MakeEvent(std::forward<T>(val)...));
+  }
+
+  void SetRateLimit(typename rate_limit_type::Mode mode, TimerWheel* wheel,
+                    TimerWheel::duration interval, bool trailing) {
+    auto limit = AllocateUnique<rate_limit_type>();
+    limit->mode = mode;
+    limit->wheel = wheel;
+    limit->interval = interval;
+    limit->trailing = trailing && wheel;
+
+    locker_type queue_locker(QueueMutex());
+    if (limit->trailing)
+      limit->timer = Allocate<rate_timer_type>(TimerToken());
+    rate_limit_ = std::move(limit);
+    rate_limited_.store(true);
+  }
+
+  // should be called with QueueMutex() held
+  static void ArmRateTimer(rate_limit_type& limit,
+                           TimerWheel::duration delay) {
+    if (limit.armed) return;
+    limit.armed = true;
+    limit.wheel->Add(limit.timer, delay);
+  }
+
+  /**
+   * @brief: Check emission against Throttle or Debounce, value that should
+   * be delivered later is kept as the trailing value
+   *
+   * @return: true if the event should be queued now
+   */
+  template <typename... T>
+  bool PassRateLimit(T&&... val) {
+    locker_type queue_locker(QueueMutex());
+    if (!rate_limit_) return true;
+
+    auto& limit = *rate_limit_;
+    const auto now = limit.Now();
+
+    if (limit.mode == rate_limit_type::kThrottle) {
+      if (!limit.has_last || now - limit.last >= limit.interval) {
+        limit.has_last = true;
+        limit.last = now;
+        // newer value is delivered now, don't deliver the older one after it
+        limit.pending.reset();
+        return true;
+      }
+
+      if (limit.trailing) {
+        limit.pending.emplace(std::forward<T>(val)...);
+        ArmRateTimer(limit, limit.last + limit.interval - now);
+      }
+      return false;
+    }
+
+    limit.pending.emplace(std::forward<T>(val)...);
+    limit.deadline = now + limit.interval;
+    ArmRateTimer(limit, limit.interval);
+    return false;
+  }
+
+  void OnRateTimer(rate_timer_type* timer) {
+    {
+      locker_type queue_locker(QueueMutex());
+      if (!rate_limit_ || rate_limit_->timer.get() != timer) return;
+
+      auto& limit = *rate_limit_;
+      limit.armed = false;
+      if (!limit.pending) return;
+
+      const auto now = limit.Now();
+      const auto due = limit.mode == rate_limit_type::kThrottle
+                           ? limit.last + limit.interval
+                           : limit.deadline;
+      if (now < due) {
+        ArmRateTimer(limit, due - now);
+        return;
+      }
+
+      limit.has_last = true;
+      limit.last = now;
+      if (!block_)
+        Enqueue(MakeEvent(std::move(*limit.pending)));
+      limit.pending.reset();
+    }
+
+    DrainOrSchedule();
+  }
+
+  // queue every expired timer of this signal under one lock
+  void QueueTimers(detail::TimerNode::batch_iterator first,
+                   detail::TimerNode::batch_iterator last) {
+    if (block_) return;
+
+    {
+      locker_type queue_locker(QueueMutex());
+      for (; first != last; ++first) {
+        auto& timer = static_cast<timer_type&>(**first);
+        if (!timer.periodic_) {
+          Enqueue(std::move(timer.event_));
+        } else if constexpr (std::is_copy_constructible_v<event_type>) {
+          Enqueue(MakeEvent(static_cast<const event_type&>(*timer.event_)));
+        }
+      }
+    }
+
+    DrainOrSchedule();
+  }
+
+  // should be called with QueueMutex() held
+  void Enqueue(event_ptr&& event) {
+    auto& queue = QueueState();
+    queue.events.emplace(std::move(event));
+    queue.emitted.fetch_add(1, std::memory_order_relaxed);
+    EVTSIGSLOT_PROBE2(queue, this, queue.events.size());
+#ifdef EVTSIGSLOT_TRACE
+    auto& tracer = trace::Tracer::Instance();
+    queue.time.push(tracer.Now());
+    tracer.Add({trace::Kind::kQueue, this, nullptr, queue.time.back(),
+                queue.time.back()});
+#endif
+
+    UpdateHighWater(queue);
+  }
+
+  // should be called with QueueMutex() held
+  static void UpdateHighWater(queue_type& queue) {
+    const auto depth = queue.events.size();
+    if (depth > queue.high_water.load(std::memory_order_relaxed))
+      queue.high_water.store(uint32_t(depth), std::memory_order_relaxed);
+  }
+
+  // append event to the shard of the calling thread, false if the signal
+  // isn't sharded
+  bool PushShard(event_ptr& event) {
+    auto queue = queue_.load(std::memory_order_acquire);
+    auto list = queue ? queue->shards.load(std::memory_order_acquire) : nullptr;
+    if (!list) return false;
+
+    auto& shard = list->shards[detail::ThreadIndex() % list->shards.size()];
+    locker_type shard_locker(shard.mutex);
+    // ticket is taken with the shard locked, a merge holding every shard
+    // can't miss an event older than one it merged
+    const uint64_t ticket =
+        list->order == ShardOrder::kEmission
+            ? list->ticket.fetch_add(1, std::memory_order_relaxed)
+            : 0;
+#ifdef EVTSIGSLOT_TRACE
+    auto& tracer = trace::Tracer::Instance();
+    const auto now = tracer.Now();
+    shard.events.push_back({std::move(event), ticket, now});
+    tracer.Add({trace::Kind::kQueue, this, nullptr, now, now});
+#else
+    shard.events.push_back({std::move(event), ticket});
+#endif
+    shard.emitted.fetch_add(1, std::memory_order_relaxed);
+    EVTSIGSLOT_PROBE2(queue, this, shard.events.size());
+    return true;
+  }
+
+  /**
+   * @brief: Move event of every shard to the signal queue, should be called
+   * with QueueMutex() held
+   * @return: false if every shard was empty
+   */
+  bool MergeShards(queue_type& queue) {
+    auto list = queue.shards.load(std::memory_order_relaxed);
+    if (!list) return false;
+
+    // shard is only locked to swap its events out, the merge runs unlocked
+    auto take = [](shard_type& shard) { shard.taken.swap(shard.events); };
+
+    if (list->order == ShardOrder::kProducer) {
+      // producer of other shard never wait for the merge
+      for (auto& shard : list->shards) {
+        locker_type shard_locker(shard.mutex);
+        take(shard);
+      }
+    } else {
+      // every shard is held at once, event queued after the merge has a
+      // newer ticket than every merged one
+      struct unlock_type {
+        shard_list& list;
+        size_t locked = 0;
+        ~unlock_type() {
+          while (locked) list.shards[--locked].mutex.unlock();
+        }
+      } unlock{*list};
+
+      for (auto& shard : list->shards) {
+        shard.mutex.lock();
+        ++unlock.locked;
+      }
+      for (auto& shard : list->shards) take(shard);
+    }
+
+    size_t count = 0;
+    for (auto& shard : list->shards) count += shard.taken.size();
+    if (!count) return false;
+
+    // taken events are dropped if the queue throws
+    struct clear_type {
+      shard_list& list;
+      ~clear_type() {
+        for (auto& shard : list.shards) shard.taken.clear();
+        list.cursors.clear();
+      }
+    } clear{*list};
+
+    auto push = [&](shard_entry& entry) {
+      queue.events.emplace(std::move(entry.event));
+#ifdef EVTSIGSLOT_TRACE
+      queue.time.push(entry.time);
+#endif
+    };
+
+    if (list->order == ShardOrder::kProducer) {
+      for (auto& shard : list->shards)
+        for (auto& entry : shard.taken) push(entry);
+    } else {
+      // each shard is already in ticket order, they are merged through a
+      // min heap of their next entry instead of sorted again
+      auto& cursors = list->cursors;
+      for (auto& shard : list->shards)
+        if (!shard.taken.empty())
+          cursors.push_back(
+              {shard.taken.data(), shard.taken.data() + shard.taken.size()});
+      auto later = [](const shard_cursor& a, const shard_cursor& b) {
+        return a.next->ticket > b.next->ticket;
+      };
+      std::make_heap(cursors.begin(), cursors.end(), later);
+      while (!cursors.empty()) {
+        std::pop_heap(cursors.begin(), cursors.end(), later);
+        auto& cursor = cursors.back();
+        push(*cursor.next);
+        if (++cursor.next == cursor.end)
+          cursors.pop_back();
+        else
+          std::push_heap(cursors.begin(), cursors.end(), later);
+      }
+    }
+
+    UpdateHighWater(queue);
+    return true;
+  }
+
+  /**
+   * @brief: Take the next event to dispatch, should be called with
+   * QueueMutex() held
+   *
+   * @param: key sequencer key owned by the calling drainer, its handed off
+   * event is dispatched before the key is released
+   */
+  event_ptr NextEvent(std::optional<size_t>& key) {
+    auto queue_ptr = queue_.load(std::memory_order_relaxed);
+    if (!queue_ptr) return nullptr;
+    auto& queue = *queue_ptr;
+
+    if (key) {
+      auto owned = queue.sequenced.find(*key);
+      if (!owned->second.empty()) {
+        auto event = std::move(owned->second.front());
+        owned->second.pop_front();
+        return event;
+      }
+      queue.sequenced.erase(owned);
+      key.reset();
+    }
+
+    while (!queue.events.empty() || MergeShards(queue)) {
+      auto event = std::move(queue.events.front());
+      queue.events.pop();
+#ifdef EVTSIGSLOT_TRACE
+      auto& tracer = trace::Tracer::Instance();
+      tracer.Add({trace::Kind::kWait, this, nullptr, queue.time.front(),
+                  tracer.Now()});
+      queue.time.pop();
+#endif
+      if (!queue.sequencer) return event;
+
+      const auto next = queue.sequencer(*event);
+      auto [owned, inserted] = queue.sequenced.try_emplace(next);
+      if (inserted) {
+        key = next;
+        return event;
+      }
+      owned->second.push_back(std::move(event));
+    }
+
+    return nullptr;
+  }
+
+  std::shared_ptr<detail::SlotTable> Table() {
+    locker_type locker(SlotMutex());
+    if (!table_) {
+      table_ = Allocate<detail::SlotTable>(resource_);
+      table_ptr_.store(table_.get(), std::memory_order_release);
+    }
+    return table_;
+  }
+
+  Binding BindSlot(slot_ptr&& slot) {
+    Binding bind(slot);
+    AddSlot(std::move(slot));
+    return bind;
+  }
+
+  // the list is protected for the whole dispatch without any lock, a slot
+  // binding or unbinding meanwhile publishes a new list
+  // @return: false when a slot destroyed the signal
+  bool DoPostEvent(event_type& event, deferred_list& deferred) {
+    detail::Trampoline::Frame frame(this);
+    detail::HazardDomain::Guard guard;
+    auto list = frame.Protect(guard, slot_list_);
+    ++deferred.serial;
+    if (!list) return true;
+
+    for (const auto& group : list->list)
+      if (!DispatchGroup(group, event, deferred, frame)) break;
+    return !frame.IsDestroyed();
+  }
+
+  // only slot whose bit is set in the group mask is touched
+  // @return: false when the event is vetoed or the signal destroyed
+  bool DispatchGroup(const group_type& group, event_type& event,
+                     deferred_list& deferred,
+                     const detail::Trampoline::Frame& frame) {
+    if (!event.IsAllowed()) return false;
+
+    group.mask->ReverseForEach([&](size_t index) {
+      if (index >= group.list.size()) return true;
+
+      const auto& slot = group.list[index];
+      if constexpr (std::is_copy_constructible_v<event_type>) {
+        if (slot->loop_ && !slot->loop_->IsInLoopThread()) {
+          Defer(event, slot, deferred);
+          return true;
+        }
+      }
+
+      event.Skip(false);
+      {
+        EVTSIGSLOT_TRACE_SPAN(
+            kSlot, static_cast<const detail::SlotState*>(slot.get()), this);
+        EVTSIGSLOT_PROBE2(slot__entry, this, slot.get());
+        slot->operator()(event);
+        EVTSIGSLOT_PROBE2(slot__return, this, slot.get());
+      }
+      return event.IsSkipped() && event.IsAllowed() && !frame.IsDestroyed();
+    });
+    return event.IsAllowed() && !frame.IsDestroyed();
+  }
+
+  // should be called with SlotMutex() held after slot is removed from the
+  // group, or the mask is full
+  void Reindex(group_type& group) const {
+    auto mask = Allocate<detail::SlotMask>(
+        std::max<size_t>(64, group.list.size() * 2), resource_);
+    for (size_t i = 0; i < group.list.size(); ++i)
+      group.list[i]->SetMask(mask, i);
+    group.mask = std::move(mask);
+  }
+
+  // the event is copied once per dispatch and loop, from the resource
+  void Defer(const event_type& event, const slot_ptr& slot,
+             deferred_list& deferred) const {
+    auto loop = std::find_if(
+        deferred.loops.begin(), deferred.loops.end(),
+        [&](const auto& it) { return it.first == slot->loop_; });
+
+    if (loop == deferred.loops.end()) {
+      deferred.loops.emplace_back(slot->loop_,
+                                  std::pmr::vector<deferred_type>(resource_));
+      loop = std::prev(deferred.loops.end());
+    }
+
+    auto& events = loop->second;
+    if (events.empty() || events.back().serial != deferred.serial)
+      events.push_back({Allocate<event_type>(event),
+                        std::pmr::vector<slot_ptr>(resource_),
+                        deferred.serial});
+
+    events.back().slots.push_back(slot);
+  }
+
+  // every slot was already delivered when the dispatch reached it, so each
+  // one gets the event with fresh flags and can't stop the others
+  static void PostDeferred(deferred_list& deferred) {
+    for (auto& [loop, events] : deferred.loops) {
+      loop->Post([events = std::move(events)]() {
+        for (const auto& item : events) {
+          for (const auto& slot : item.slots) {
+            static_cast<internal::EmptyEvent&>(*item.event) =
+                internal::EmptyEvent();
+            slot->operator()(*item.event);
+          }
+        }
+      });
+    }
   }
 
   void AddSlot(slot_ptr&& slot) {
-    locker_type locker(slot_mutex_);
+    snapshot_type* old;
+    {
+      locker_type locker(SlotMutex());
+      // the list is only copied when its group is full, so binding N slot
+      // copies it log N times
+      if (expired_.load(std::memory_order_relaxed) < kCleanThreshold &&
+          AppendSlot(slot))
+        return;
+
+      auto write = CopySlots();
+      // the list is copied anyway, so signal that isn't drained again still
+      // drops its expired slot
+      if (expired_.load(std::memory_order_relaxed) >= kCleanThreshold &&
+          expired_.exchange(0, std::memory_order_relaxed)) {
+        auto expired = [](const auto& it) { return !it->IsBinded(); };
+        EraseSlots(write->list, expired);
+      }
+      InsertSlot(write->list, std::move(slot));
+      old = PublishSlots(std::move(write));
+    }
+    RetireSlots(old);
+  }
+
+  // should be called with SlotMutex() held, slot is appended to the
+  // published list when its group has room in both its array and its mask
+  bool AppendSlot(slot_ptr& slot) {
+    auto list = slot_list_.load(std::memory_order_relaxed);
+    if (!list) return false;
+
+    for (auto& group : list->list) {
+      if (group.id != slot->group_id_) continue;
 
-    auto& group_list = detail::CowWrite(slot_list_);
+      const auto index = group.list.size();
+      if (index == group.list.capacity() || !group.mask ||
+          index >= group.mask->Capacity())
+        return false;
 
+      // emitter seeing the bit skips the slot until it sees the size
+      EVTSIGSLOT_PROBE2(bind, this, slot.get());
+      slot->SetMask(group.mask, index);
+      group.list.push_back(std::move(slot));
+      slot_count_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  // should be called with SlotMutex() held
+  void InsertSlot(list_type& group_list, slot_ptr&& slot) {
     typename list_type::iterator it =
         std::find_if(group_list.begin(), group_list.end(),
                      [&](auto& it) { return it.id == slot->group_id_; });
 
     if (it == group_list.end()) {
-      group_type group;
-      group.id = slot->group_id_;
-      group_list.emplace_back(group);
-
-      it = std::find_if(
-          group_list.begin(), group_list.end(),
-          [&](const group_type& it) { return it.id == slot->group_id_; });
+      group_list.emplace_back().id = slot->group_id_;
+      it = std::prev(group_list.end());
     }
 
-    it->list.push_front(std::move(slot));
+    EVTSIGSLOT_PROBE2(bind, this, slot.get());
+    it->list.push_back(std::move(slot));
+    slot_count_.fetch_add(1, std::memory_order_relaxed);
+    auto index = it->list.size() - 1;
+    if (it->mask && index < it->mask->Capacity())
+      it->list.back()->SetMask(it->mask, index);
+    else
+      Reindex(*it);
   }
 
   template <typename Cond>
   size_t DoUnbindIf(Cond func) {
-    locker_type locker(slot_mutex_);
-    auto& ref = detail::CowWrite(slot_list_);
-    size_t idx = 0, count = 0;
+    snapshot_type* old = nullptr;
+    size_t count = 0;
+    {
+      locker_type locker(SlotMutex());
+      if (!slot_list_.load(std::memory_order_relaxed)) return 0;
+
+      // list is left alone when nothing matches
+      auto write = CopySlots();
+      count = EraseSlots(write->list, func);
+      if (count) old = PublishSlots(std::move(write));
+    }
+    RetireSlots(old);
+    return count;
+  }
+
+  // should be called with SlotMutex() held
+  template <typename Cond>
+  size_t EraseSlots(list_type& group_list, Cond& func) {
+    size_t count = 0;
+
+    for (auto group = group_list.begin(); group != group_list.end();
+         ++group) {
+      auto it = std::remove_if(group->list.begin(), group->list.end(),
+                               [&](const auto& slot) {
+                                 if (!func(slot)) return false;
+                                 EVTSIGSLOT_PROBE2(unbind, this, slot.get());
+                                 slot->Detach();
+                                 return true;
+                               });
+      if (it == group->list.end()) continue;
 
-    for (auto group = detail::CowWrite(slot_list_).begin();
-         group != detail::CowWrite(slot_list_).end(); ++group) {
-      auto it = group->list.begin();
-      while (it != group->list.end())
-        if (func(*it)) {
-          it = group->list.erase(it);
-          ++count;
-        } else
-          ++it;
+      count += std::distance(it, group->list.end());
+      group->list.erase(it, group->list.end());
+      Reindex(*group);
     }
 
+    slot_count_.fetch_sub(count, std::memory_order_relaxed);
+
     return count;
   }
 
+  // the slot may destroy the signal, the frame tells
+  void Drain() override {
+    detail::Trampoline::Frame frame(this);
+    auto queue = queue_.load(std::memory_order_acquire);
+    queue->draining.store(true);
+    queue->scheduled.store(false);
+    ProcessEvent();
+    if (!frame.IsDestroyed()) queue->draining.store(false);
+  }
+
+  // remove every expired slot in one pass instead of one pass per slot
+  void CleanExpired() {
+    if (expired_.load(std::memory_order_relaxed) == 0) return;
+    // expired meanwhile is counted for the next clean
+    if (expired_.exchange(0, std::memory_order_relaxed) == 0) return;
+
+    DoUnbindIf([](const auto& it) { return !it->IsBinded(); });
+  }
+
+ protected:
+  // overridden by signal that should know when its slot go away, the
+  // override should call the one of Signal first
+  void CleanLater(detail::SlotState*) override {
+    expired_.fetch_add(1, std::memory_order_relaxed);
+  }
+
   void Clean(detail::SlotState* state) override {
-    locker_type locker(slot_mutex_);
+    snapshot_type* old = nullptr;
+    {
+      locker_type locker(SlotMutex());
+      if (!slot_list_.load(std::memory_order_relaxed)) return;
+
+      auto write = CopySlots();
+      if (EraseSlot(write->list, state)) old = PublishSlots(std::move(write));
+    }
+    RetireSlots(old);
+  }
 
-    static int i = 0;
-    auto& write = detail::CowWrite(slot_list_);
-    for (auto group = write.begin(); group != write.end(); ++group) {
+ private:
+  // should be called with SlotMutex() held
+  bool EraseSlot(list_type& group_list, detail::SlotState* state) {
+    for (auto group = group_list.begin(); group != group_list.end();
+         ++group) {
       for (auto it = group->list.begin(); it != group->list.end(); ++it) {
         if (it->get() == state) {
+          EVTSIGSLOT_PROBE2(unbind, this, state);
           group->list.erase(it);
-          return;
+          Reindex(*group);
+          slot_count_.fetch_sub(1, std::memory_order_relaxed);
+          return true;
         }
       }
     }
+    return false;
   }
 };
 
+/**
+ * Signal of common Emitted is instantiated once in the evtsigslot-instances
+ * library, translation unit built with EVTSIGSLOT_EXTERN_TEMPLATE only
+ * reference it instead of instantiating every member again
+ */
+#ifdef EVTSIGSLOT_EXTERN_TEMPLATE
+extern template class Signal<void>;
+extern template class Signal<bool>;
+extern template class Signal<int>;
+extern template class Signal<double>;
+extern template class Signal<std::string>;
+#endif
+
 }  // namespace evtsigslot
 
 #endif /* end of include guard: FMR_EVTSIGSLOT_SIGNAL */
@@ -27,15 +27,28 @@
 
 #include <evtsigslot/event.h>
 #include <evtsigslot/func_ptr.h>
+#include <evtsigslot/observer.h>
 #include <evtsigslot/slot_state.h>
 
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 namespace evtsigslot {
 
+class EventLoop;
+
 struct Cleanable {
   virtual ~Cleanable() = default;
   virtual void Clean(detail::SlotState*) = 0;
+
+  /**
+   * @brief: Called by slot whose tracked object expired, the slot is already
+   * unbinded so it can be removed later with other expired slot
+   */
+  virtual void CleanLater(detail::SlotState* state) { Clean(state); }
 };
 
 namespace internal {
@@ -52,12 +65,15 @@ class Slot : public detail::SlotState {
     bool is_blocked = IsBlocked();
     if (IsBinded() && !is_blocked) {
       DoCall(val);
-    } else
+    } else {
       val.Skip();
+      ExpireDead();
+    }
   };
 
   using event_type = Event<Emitted>;
   using value_type = Emitted;
+  using result_type = void;
 
   virtual func_ptr GetCallable() = 0;
 
@@ -65,6 +81,9 @@ class Slot : public detail::SlotState {
 
   int group_id_ = 0;
 
+  // when set, slot is only called on the loop thread
+  EventLoop* loop_ = nullptr;
+
   template <typename T>
   bool HasCallable(T&& t) {
     auto func_ptr = get_function_ptr(t);
@@ -78,18 +97,61 @@ class Slot : public detail::SlotState {
 
   virtual void DoCall(event_type& event) = 0;
 
+  void Expire() {
+    if (Detach()) cleaner_.CleanLater(this);
+  }
+
+  // slot reporting itself unbinded while still flagged binded, like a
+  // tracked slot whose object expired, is expired by the dispatch reaching
+  // it instead of by IsBinded
+  void ExpireDead() {
+    if (!IsBinded() && SlotState::IsBinded()) Expire();
+  }
+
  private:
   Cleanable& cleaner_;
 };
 
-template <typename Callable, typename Class, typename Emitted>
-class SlotClass : public Slot<Emitted> {
+/**
+ * @brief: Slot returning Result, the result is only collected by
+ * Signal::Emit and dropped when the slot is called from the queue
+ */
+template <typename Emitted, typename Result>
+class ResultSlot : public Slot<Emitted> {
+ public:
+  using Slot<Emitted>::Slot;
+  using typename Slot<Emitted>::event_type;
+  using result_type = Result;
+
+  /**
+   * @return: nullopt when the slot is blocked, unbinded or its tracked
+   * object expired
+   */
+  std::optional<Result> Invoke(event_type& event) {
+    if (!this->IsBinded() || this->IsBlocked()) {
+      this->ExpireDead();
+      return std::nullopt;
+    }
+    return DoInvoke(event);
+  }
+
+ protected:
+  virtual std::optional<Result> DoInvoke(event_type& event) = 0;
+};
+
+template <typename Emitted, typename Result>
+using slot_base_t = std::conditional_t<std::is_void_v<Result>, Slot<Emitted>,
+                                       ResultSlot<Emitted, Result>>;
+
+template <typename Callable, typename Class, typename Emitted,
+          typename Result = void>
+class SlotClass : public slot_base_t<Emitted, Result> {
   Class class_ptr_;
   Callable callable_;
 
  public:
   SlotClass(Cleanable& c, Callable&& callable, Class class_ptr)
-      : Slot<Emitted>(c),
+      : slot_base_t<Emitted, Result>(c),
         callable_(std::forward<Callable>(callable)),
         class_ptr_(class_ptr) {}
 
@@ -109,16 +171,141 @@ class SlotClass : public Slot<Emitted> {
     (GetClassPtr()->*callable_)(std::forward<Args>(args)...);
   }
 
+  template <typename R, typename... Args>
+  std::optional<R> CallResult(Args&&... args) {
+    return std::optional<R>(std::in_place, (GetClassPtr()->*callable_)(
+                                               std::forward<Args>(args)...));
+  }
+
   virtual bool HasObject(const void* obj) override { return obj == class_ptr_; }
 };
 
-template <typename Callable, typename Emitted>
-class SlotFunc : public Slot<Emitted> {
+/**
+ * @brief: Slot calling member function of object tracked through a weak_ptr,
+ * binding doesn't extend the object lifetime. Once the object is gone the
+ * slot reports itself unbinded and is removed later by its owner.
+ */
+template <typename Callable, typename Class, typename Emitted,
+          typename Result = void>
+class SlotTracked : public slot_base_t<Emitted, Result> {
+  using weak_type = decltype(to_weak(std::declval<Class>()));
+
+  weak_type object_;
+  Callable callable_;
+
+ public:
+  SlotTracked(Cleanable& c, Callable&& callable, Class class_ptr)
+      : slot_base_t<Emitted, Result>(c),
+        object_(to_weak(class_ptr)),
+        callable_(std::forward<Callable>(callable)) {}
+
+  using typename Slot<Emitted>::event_type;
+  using typename Slot<Emitted>::value_type;
+
+  // expired() only reads the use count, the object is not locked here
+  virtual bool IsBinded() const noexcept override {
+    return Slot<Emitted>::IsBinded() && !object_.expired();
+  }
+
+  virtual func_ptr GetCallable() override {
+    return get_function_ptr(callable_);
+  }
+
+ protected:
+  template <typename... Args>
+  void Call(Args&&... args) {
+    // object may still expire after IsBinded
+    if (auto object = object_.lock())
+      ((*object).*callable_)(std::forward<Args>(args)...);
+    else
+      this->Expire();
+  }
+
+  template <typename R, typename... Args>
+  std::optional<R> CallResult(Args&&... args) {
+    if (auto object = object_.lock())
+      return std::optional<R>(
+          std::in_place, ((*object).*callable_)(std::forward<Args>(args)...));
+
+    this->Expire();
+    return std::nullopt;
+  }
+
+  virtual bool HasObject(const void* obj) override {
+    return obj == object_.lock().get();
+  }
+};
+
+/**
+ * @brief: Slot calling member function of an Observer, linked into the
+ * observer so it can be unbinded when the observer is destroyed
+ */
+template <typename Callable, typename Class, typename Emitted,
+          typename Result = void>
+class SlotObserver
+    : public SlotClass<Callable, Class, Emitted, Result>,
+      public detail::ObserverLink,
+      public std::enable_shared_from_this<
+          SlotObserver<Callable, Class, Emitted, Result>> {
+ public:
+  SlotObserver(Cleanable& c, Callable&& callable, Class class_ptr)
+      : SlotClass<Callable, Class, Emitted, Result>(
+            c, std::forward<Callable>(callable), class_ptr),
+        state_(static_cast<const Observer*>(class_ptr)->State()) {
+    std::scoped_lock<std::mutex> locker(state_->mutex);
+    state_->head.PushBack(this);
+  }
+
+  ~SlotObserver() {
+    std::scoped_lock<std::mutex> locker(state_->mutex);
+    Unlink();
+  }
+
+  std::shared_ptr<void> Retain() override {
+    return this->weak_from_this().lock();
+  }
+
+  void Release() override { this->Expire(); }
+
+ protected:
+  // checked again once counted, UnbindAll either sees the call or the call
+  // sees the slot unbinded
+  template <typename... Args>
+  void Call(Args&&... args) {
+    detail::ObserverCall call(*state_);
+    if (this->IsBinded()) base_type::Call(std::forward<Args>(args)...);
+  }
+
+  template <typename R, typename... Args>
+  std::optional<R> CallResult(Args&&... args) {
+    detail::ObserverCall call(*state_);
+    if (!this->IsBinded()) return std::nullopt;
+    return base_type::template CallResult<R>(std::forward<Args>(args)...);
+  }
+
+ private:
+  using base_type = SlotClass<Callable, Class, Emitted, Result>;
+
+  std::shared_ptr<detail::ObserverState> state_;
+};
+
+template <typename Callable, typename Class, typename Emitted,
+          typename Result = void>
+using slot_class_t = std::conditional_t<
+    trait::is_weak_ptr_compatible_v<Class>,
+    SlotTracked<Callable, Class, Emitted, Result>,
+    std::conditional_t<trait::is_observer_v<std::decay_t<Class>>,
+                       SlotObserver<Callable, Class, Emitted, Result>,
+                       SlotClass<Callable, Class, Emitted, Result>>>;
+
+template <typename Callable, typename Emitted, typename Result = void>
+class SlotFunc : public slot_base_t<Emitted, Result> {
   Callable callable_;
 
  public:
   SlotFunc(Cleanable& c, Callable&& callable)
-      : Slot<Emitted>(c), callable_{std::forward<Callable>(callable)} {}
+      : slot_base_t<Emitted, Result>(c),
+        callable_{std::forward<Callable>(callable)} {}
 
   using typename Slot<Emitted>::event_type;
   using typename Slot<Emitted>::value_type;
@@ -135,6 +322,12 @@ class SlotFunc : public Slot<Emitted> {
     callable_(std::forward<Args>(args)...);
   }
 
+  template <typename R, typename... Args>
+  std::optional<R> CallResult(Args&&... args) {
+    return std::optional<R>(std::in_place,
+                            callable_(std::forward<Args>(args)...));
+  }
+
   virtual func_ptr GetCallable() override {
     return get_function_ptr(callable_);
   }
@@ -142,7 +335,7 @@ class SlotFunc : public Slot<Emitted> {
   virtual bool HasObject(const void* obj) override { return false; }
 };
 
-template <typename SlotHelperClass, typename Traits>
+template <typename SlotHelperClass, typename Traits, typename = void>
 class SlotHelper : public SlotHelperClass {
  public:
   using Base = SlotHelperClass;
@@ -164,6 +357,32 @@ class SlotHelper : public SlotHelperClass {
   }
 };
 
+/**
+ * @brief: SlotHelper of slot returning a result, chosen only once the slot
+ * type is complete, the call dropping the result is inherited
+ */
+template <typename SlotHelperClass, typename Traits>
+class SlotHelper<SlotHelperClass, Traits,
+                 std::enable_if_t<!std::is_void_v<
+                     typename SlotHelperClass::result_type>>>
+    : public SlotHelper<SlotHelperClass, Traits, std::false_type> {
+ public:
+  using Base = SlotHelper<SlotHelperClass, Traits, std::false_type>;
+  using Base::Base;
+  using typename Base::event_type;
+  using result_type = typename SlotHelperClass::result_type;
+
+ protected:
+  virtual std::optional<result_type> DoInvoke(event_type& val) override {
+    if constexpr (Traits::is_callable_with_event)
+      return this->template CallResult<result_type>(val);
+    else if constexpr (Traits::is_callable_without_args)
+      return this->template CallResult<result_type>();
+    else
+      return this->template CallResult<result_type>(val.Get());
+  }
+};
+
 template <typename Callable, typename Class, typename... Emitted>
 constexpr std::shared_ptr<Slot<Emitted...>> MakeSlot(Cleanable& cleanable,
                                                      Callable&& callable,
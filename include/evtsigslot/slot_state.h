@@ -23,6 +23,10 @@
  */
 
 #include <atomic>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
 
 #ifndef EVTSIGSLOT_SLOT_STATE
 #define EVTSIGSLOT_SLOT_STATE
@@ -31,33 +35,150 @@ namespace evtsigslot {
 
 namespace detail {
 
+/**
+ * @brief: One bit per slot of a group, set while the slot is binded and not
+ * blocked, so dispatch can skip dead slot a word at a time without touching
+ * the slot itself
+ */
+class SlotMask {
+ public:
+  explicit SlotMask(
+      size_t capacity,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : words_((capacity + 63) / 64, resource) {}
+
+  size_t Capacity() const noexcept { return words_.size() * 64; }
+
+  void Set(size_t index, bool live) noexcept {
+    const uint64_t bit = uint64_t(1) << (index % 64);
+    if (live)
+      words_[index / 64].fetch_or(bit, std::memory_order_relaxed);
+    else
+      words_[index / 64].fetch_and(~bit, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief: Call func with the index of every set bit from the highest one
+   * until it returns false
+   */
+  template <typename Func>
+  void ReverseForEach(Func&& func) const {
+    for (size_t word = words_.size(); word-- > 0;) {
+      auto bits = words_[word].load(std::memory_order_relaxed);
+      while (bits) {
+        const unsigned bit = HighestBit(bits);
+        if (!func(word * 64 + bit)) return;
+        bits &= ~(uint64_t(1) << bit);
+      }
+    }
+  }
+
+ private:
+  static unsigned HighestBit(uint64_t bits) noexcept {
+#if defined __clang__ || defined __GNUC__
+    return 63 - __builtin_clzll(bits);
+#else
+    unsigned ret = 0;
+    while (bits >>= 1) ++ret;
+    return ret;
+#endif
+  }
+
+  std::pmr::vector<std::atomic<uint64_t>> words_;
+};
+
 class SlotState {
  public:
-  SlotState() : binded_(true), blocked_(false) {}
+  SlotState() {
+    flags_.binded = true;
+    flags_.blocked = false;
+  }
 
   auto Index() const { return index_; }
   auto& Index() { return index_; }
 
-  virtual bool IsBinded() const noexcept { return binded_; }
-  virtual bool IsBlocked() const noexcept { return blocked_; }
+  virtual bool IsBinded() const noexcept { return flags_.binded; }
+  virtual bool IsBlocked() const noexcept { return flags_.blocked; }
 
   bool Unbind() noexcept {
-    bool ret = binded_.exchange(false);
+    bool ret = flags_.binded.exchange(false);
     if (ret) {
+      UpdateMask();
+      OnUnbind();
       OnDisconnect();
     }
     return ret;
   }
 
-  void Block() noexcept { blocked_.store(true); }
-  void Unblock() noexcept { blocked_.store(false); }
+  /**
+   * @brief: Mark as unbinded without notifying the owner, used when the owner
+   * is going away
+   * @return: true if it was binded
+   */
+  bool Detach() noexcept {
+    bool ret = flags_.binded.exchange(false);
+    if (ret) {
+      UpdateMask();
+      OnUnbind();
+    }
+    return ret;
+  }
+
+  void Block() noexcept {
+    flags_.blocked.store(true);
+    UpdateMask();
+  }
+
+  void Unblock() noexcept {
+    flags_.blocked.store(false);
+    UpdateMask();
+  }
+
+  /**
+   * @brief: Move slot to bit index of the group mask, called by the owner
+   * whenever the group is rebuilt
+   */
+  void SetMask(std::shared_ptr<SlotMask> mask, std::size_t index) noexcept {
+    MaskLocker locker(flags_.mask_lock);
+    mask_ = std::move(mask);
+    index_ = index;
+    mask_->Set(index_, flags_.binded && !flags_.blocked);
+  }
 
  protected:
   virtual void OnDisconnect() {}
 
+  // called once when the slot stop being binded, before the owner is notified
+  virtual void OnUnbind() noexcept {}
+
  private:
-  std::size_t index_;
-  std::atomic_bool binded_, blocked_;
+  struct MaskLocker {
+    explicit MaskLocker(std::atomic_flag& flag) noexcept : flag_(flag) {
+      while (flag_.test_and_set(std::memory_order_acquire)) {
+      }
+    }
+    ~MaskLocker() { flag_.clear(std::memory_order_release); }
+    std::atomic_flag& flag_;
+  };
+
+  // flag is read under the lock so the last writer always leaves the right bit
+  void UpdateMask() noexcept {
+    MaskLocker locker(flags_.mask_lock);
+    if (mask_) mask_->Set(index_, flags_.binded && !flags_.blocked);
+  }
+
+  std::size_t index_ = 0;
+  std::shared_ptr<SlotMask> mask_;
+
+  // written by Block and Unbind from any thread. Left on the line of the
+  // callable: dispatch reads both for every live slot, and those writes are
+  // too rare to pay a padded line per slot over a large list
+  struct flags_type {
+    std::atomic_bool binded, blocked;
+    std::atomic_flag mask_lock = ATOMIC_FLAG_INIT;
+  };
+
+  flags_type flags_;
 };
 
 }  // namespace detail
@@ -0,0 +1,308 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2021 Uskrai
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef EVTSIGSLOT_SLOT_TABLE
+#define EVTSIGSLOT_SLOT_TABLE
+
+#include <evtsigslot/binding.h>
+#include <evtsigslot/slot_state.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace evtsigslot {
+
+namespace detail {
+
+/**
+ * @brief: Table of generation and blocked flag indexed by BindingId. Entry is
+ * allocated in chunk of growing size that is never moved, so lookup only
+ * loads atomic and never takes a lock or a reference count.
+ *
+ * Entry generation is bumped when its slot is unbinded, which makes every
+ * BindingId of the previous owner stale before the entry is reused.
+ *
+ * Block, Unblock and Unbind by id go through the SlotState of the entry so
+ * its group mask follows, the slot destructor waits for the entry users
+ * instead of the operation taking a reference count.
+ */
+class SlotTable {
+ public:
+  /**
+   * @param: resource chunk is allocated from, should outlive the table
+   */
+  explicit SlotTable(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : resource_(resource) {}
+  SlotTable(const SlotTable&) = delete;
+  SlotTable& operator=(const SlotTable&) = delete;
+
+  ~SlotTable() {
+    for (unsigned chunk = 0; chunk < kChunks; ++chunk) {
+      if (auto entries = chunks_[chunk].load())
+        resource_->deallocate(entries, sizeof(Entry) * ChunkSize(chunk),
+                              alignof(Entry));
+    }
+  }
+
+  BindingId Acquire() {
+    locker_type locker(mutex_);
+
+    uint32_t index;
+    if (free_ != kNone) {
+      index = free_;
+      free_ = Find(index)->next_free;
+    } else {
+      index = size_++;
+      auto& chunk = chunks_[ChunkOf(index)];
+      if (!chunk.load(std::memory_order_relaxed))
+        chunk.store(AllocateChunk(ChunkSize(ChunkOf(index))),
+                    std::memory_order_release);
+    }
+
+    auto entry = Find(index);
+    uint32_t generation = Generation(entry->word.load());
+    if (generation == 0) {
+      generation = 1;
+      entry->word.store(uint64_t(generation) << 32);
+    }
+    return BindingId(index, generation);
+  }
+
+  /**
+   * @brief: Make id stale and put its entry back to the free list
+   * @return: true if id was still valid
+   */
+  bool Release(BindingId id) noexcept {
+    locker_type locker(mutex_);
+    auto entry = Find(id.Index());
+    if (!entry || Generation(entry->word.load()) != id.Generation())
+      return false;
+
+    uint32_t next = id.Generation() + 1;
+    entry->word.store(uint64_t(next ? next : 1) << 32);
+    entry->state.store(nullptr);
+    entry->next_free = free_;
+    free_ = id.Index();
+    return true;
+  }
+
+  bool IsBinded(BindingId id) const noexcept {
+    auto entry = Find(id.Index());
+    return entry && Generation(entry->word.load()) == id.Generation();
+  }
+
+  bool IsBlocked(BindingId id) const noexcept {
+    auto entry = Find(id.Index());
+    if (!entry) return false;
+
+    auto word = entry->word.load();
+    return Generation(word) == id.Generation() && (word & kBlocked);
+  }
+
+  /**
+   * @brief: Let id reach state, called once by the slot owning id
+   */
+  void Attach(BindingId id, SlotState* state) noexcept {
+    if (auto entry = Find(id.Index())) entry->state.store(state);
+  }
+
+  /**
+   * @brief: Forget state before it is destroyed, waits for the id
+   * operation using it
+   */
+  void Detach(BindingId id, SlotState* state) noexcept {
+    auto entry = Find(id.Index());
+    if (!entry) return;
+
+    entry->state.compare_exchange_strong(state, nullptr);
+    while (entry->users.load()) std::this_thread::yield();
+  }
+
+  /**
+   * @return: false if id is stale
+   */
+  bool SetBlocked(BindingId id, bool blocked) noexcept {
+    auto entry = Find(id.Index());
+    if (!entry) return false;
+
+    auto word = entry->word.load();
+    do {
+      if (Generation(word) != id.Generation()) return false;
+    } while (!entry->word.compare_exchange_weak(
+        word, blocked ? word | kBlocked : word & ~kBlocked));
+
+    Use(*entry, id, [&](SlotState& state) {
+      if (blocked)
+        state.Block();
+      else
+        state.Unblock();
+    });
+    return true;
+  }
+
+  /**
+   * @brief: Unbind the slot of id without notifying its owner, the slot
+   * releases id itself
+   * @return: false if id is stale
+   */
+  bool Unbind(BindingId id) noexcept {
+    auto entry = Find(id.Index());
+    if (!entry || Generation(entry->word.load()) != id.Generation())
+      return false;
+
+    bool ret = false;
+    if (!Use(*entry, id, [&](SlotState& state) { ret = state.Detach(); }))
+      ret = Release(id);
+    return ret;
+  }
+
+ private:
+  using locker_type = std::scoped_lock<std::mutex>;
+
+  static constexpr uint64_t kBlocked = 1;
+  static constexpr uint32_t kNone = ~uint32_t(0);
+  static constexpr unsigned kBaseBits = 6;
+  static constexpr unsigned kChunks = 32 - kBaseBits;
+
+  struct Entry {
+    // generation in the upper half, flag in the lower half
+    std::atomic<uint64_t> word{0};
+    // slot owning the current generation, cleared by Release or by the
+    // slot destructor once users drops to 0
+    std::atomic<SlotState*> state{nullptr};
+    std::atomic_uint32_t users{0};
+    uint32_t next_free = kNone;
+  };
+
+  // state is counted as used before it is read, so Detach either sees the
+  // user or the user sees the cleared state. Generation is checked again
+  // once state is read: entry released and reused since the caller checked
+  // it has a new generation, and its new slot is left alone
+  template <typename Func>
+  static bool Use(Entry& entry, BindingId id, Func&& func) noexcept {
+    entry.users.fetch_add(1);
+    auto state = entry.state.load();
+    const bool owned =
+        state && Generation(entry.word.load()) == id.Generation();
+    if (owned) func(*state);
+    entry.users.fetch_sub(1, std::memory_order_release);
+    return owned;
+  }
+
+  static uint32_t Generation(uint64_t word) noexcept {
+    return uint32_t(word >> 32);
+  }
+
+  static unsigned Log2(uint64_t value) noexcept {
+#if defined __clang__ || defined __GNUC__
+    return 63 - __builtin_clzll(value);
+#else
+    unsigned ret = 0;
+    while (value >>= 1) ++ret;
+    return ret;
+#endif
+  }
+
+  // chunk k holds index [base * (2^k - 1), base * (2^(k + 1) - 1))
+  static unsigned ChunkOf(uint32_t index) noexcept {
+    return Log2((uint64_t(index) >> kBaseBits) + 1);
+  }
+
+  static size_t ChunkSize(unsigned chunk) noexcept {
+    return size_t(1) << (kBaseBits + chunk);
+  }
+
+  // Entry is trivially destructible so the chunk is only deallocated
+  Entry* AllocateChunk(size_t size) {
+    auto entries = static_cast<Entry*>(
+        resource_->allocate(sizeof(Entry) * size, alignof(Entry)));
+    for (size_t i = 0; i < size; ++i) new (entries + i) Entry;
+    return entries;
+  }
+
+  Entry* Find(uint32_t index) const noexcept {
+    unsigned chunk = ChunkOf(index);
+    if (chunk >= kChunks) return nullptr;
+
+    auto entries = chunks_[chunk].load(std::memory_order_acquire);
+    if (!entries) return nullptr;
+    return entries + (index - (ChunkSize(chunk) - ChunkSize(0)));
+  }
+
+  std::pmr::memory_resource* resource_;
+  std::atomic<Entry*> chunks_[kChunks] = {};
+  std::mutex mutex_;
+  uint32_t size_ = 0;
+  uint32_t free_ = kNone;
+};
+
+/**
+ * @brief: Slot binded through a BindingId, it is binded and blocked according
+ * to its table entry as well as its own state
+ */
+template <typename SlotType>
+class SlotEntry : public SlotType {
+ public:
+  template <typename... Args>
+  explicit SlotEntry(std::shared_ptr<SlotTable> table, Args&&... args)
+      : SlotType(std::forward<Args>(args)...),
+        table_(std::move(table)),
+        id_(table_->Acquire()) {
+    table_->Attach(id_, this);
+  }
+
+  ~SlotEntry() {
+    table_->Detach(id_, this);
+    table_->Release(id_);
+  }
+
+  BindingId Id() const noexcept { return id_; }
+
+  virtual bool IsBinded() const noexcept override {
+    return SlotType::IsBinded() && table_->IsBinded(id_);
+  }
+
+  virtual bool IsBlocked() const noexcept override {
+    return SlotType::IsBlocked() || table_->IsBlocked(id_);
+  }
+
+ protected:
+  virtual void OnUnbind() noexcept override { table_->Release(id_); }
+
+ private:
+  std::shared_ptr<SlotTable> table_;
+  BindingId id_;
+};
+
+}  // namespace detail
+
+}  // namespace evtsigslot
+
+#endif /* end of include guard: EVTSIGSLOT_SLOT_TABLE */
@@ -59,6 +59,29 @@ struct slot_traits_helper {
   using type = SlotHelper<SlotType, slot_traits_helper<flags, SlotType>>;
 };
 
+// Result given after Emitted in the typelist, void when missing
+template <typename... Result>
+struct slot_result {
+  using type = void;
+};
+
+template <typename Result>
+struct slot_result<Result> {
+  using type = Result;
+};
+
+template <typename... Result>
+using slot_result_t = typename slot_result<Result...>::type;
+
+template <typename Callable, typename EmittedList, typename... Result>
+using slot_func_type =
+    SlotFunc<Callable, EmittedList, slot_result_t<Result...>>;
+
+template <typename Callable, typename Class, typename EmittedList,
+          typename... Result>
+using slot_class_type =
+    slot_class_t<Callable, Class, EmittedList, slot_result_t<Result...>>;
+
 /**
  * @brief: SlotTraitCaller Helper for defining New Caller ( Function, Member
  * Function, Member function of smart pointer )
@@ -139,31 +162,38 @@ using slot_traits_caller_helper_lister =
                               trait::typelist<Caller...>>;
 
 /**
- * @brief: SlotTraits for Function
+ * @brief: SlotTraits for Function, the typelist may hold the slot Result
+ * after Emitted
  */
-template <typename Callable, typename EmittedList>
+template <typename Callable, typename EmittedList, typename... Result>
 struct slot_traits<
-    trait::typelist<EmittedList>, Callable,
+    trait::typelist<EmittedList, Result...>, Callable,
     typename std::enable_if<
         slot_traits_caller_helper_lister<
-            EmittedList, SlotFunc<Callable, EmittedList>, Callable>::value,
+            EmittedList, slot_func_type<Callable, EmittedList, Result...>,
+            Callable>::value,
         void>::type>
     : slot_traits_caller_helper_lister<
-          EmittedList, SlotFunc<Callable, EmittedList>, Callable> {};
+          EmittedList, slot_func_type<Callable, EmittedList, Result...>,
+          Callable> {};
 
 /**
- * @brief: SlotTraits for Member Function
+ * @brief: SlotTraits for Member Function, object held by shared_ptr or
+ * weak_ptr is tracked weakly
  */
-template <typename Callable, typename Class, typename EmittedList>
-struct slot_traits<trait::typelist<EmittedList>, Callable, Class,
-                   typename std::enable_if<
-                       slot_traits_caller_helper_lister<
-                           EmittedList, SlotClass<Callable, Class, EmittedList>,
-                           Callable, Class>::value,
-                       void>::type>
-    : slot_traits_caller_helper_lister<EmittedList,
-                                       SlotClass<Callable, Class, EmittedList>,
-                                       Callable, Class> {};
+template <typename Callable, typename Class, typename EmittedList,
+          typename... Result>
+struct slot_traits<
+    trait::typelist<EmittedList, Result...>, Callable, Class,
+    typename std::enable_if<
+        slot_traits_caller_helper_lister<
+            EmittedList,
+            slot_class_type<Callable, Class, EmittedList, Result...>,
+            Callable, Class>::value,
+        void>::type>
+    : slot_traits_caller_helper_lister<
+          EmittedList, slot_class_type<Callable, Class, EmittedList, Result...>,
+          Callable, Class> {};
 
 template <typename... U>
 constexpr bool slot_traits_value = slot_traits<U...>::value;
@@ -0,0 +1,336 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2021 Uskrai
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef EVTSIGSLOT_TIMER_WHEEL
+#define EVTSIGSLOT_TIMER_WHEEL
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace evtsigslot {
+
+class TimerWheel;
+
+namespace detail {
+
+struct TimerLink {
+  TimerLink* prev_ = this;
+  TimerLink* next_ = this;
+
+  bool IsLinked() const noexcept { return next_ != this; }
+
+  void Unlink() noexcept {
+    prev_->next_ = next_;
+    next_->prev_ = prev_;
+    prev_ = next_ = this;
+  }
+
+  void PushBack(TimerLink* link) noexcept {
+    link->prev_ = prev_;
+    link->next_ = this;
+    prev_->next_ = link;
+    prev_ = link;
+  }
+};
+
+class TimerNode : public TimerLink {
+ public:
+  using batch_type = std::vector<std::shared_ptr<TimerNode>>;
+  using batch_iterator = batch_type::iterator;
+
+  virtual ~TimerNode() = default;
+
+  /**
+   * @brief: Called outside the wheel lock with every expired node that has the
+   * same Target, in expiration order
+   */
+  virtual void Deliver(batch_iterator first, batch_iterator last) = 0;
+
+  virtual const void* Target() const noexcept = 0;
+
+ private:
+  friend class ::evtsigslot::TimerWheel;
+
+  uint64_t expire_ = 0, period_ = 0;
+  bool cancelled_ = false;
+
+  // keep node alive while it is in the wheel
+  std::shared_ptr<TimerNode> self_;
+};
+
+}  // namespace detail
+
+/**
+ * @brief: Handle for timer added to TimerWheel
+ */
+class Timer {
+ public:
+  Timer() = default;
+
+  bool IsPending() const noexcept;
+
+  /**
+   * @brief: Stop timer from expiring again
+   * @return: true if timer was still pending
+   */
+  bool Cancel() noexcept;
+
+ private:
+  friend class TimerWheel;
+  Timer(TimerWheel* wheel, std::weak_ptr<detail::TimerNode> node) noexcept
+      : wheel_(wheel), node_(std::move(node)) {}
+
+  TimerWheel* wheel_ = nullptr;
+  std::weak_ptr<detail::TimerNode> node_;
+};
+
+/**
+ * @brief: Hierarchical timing wheel, insert and cancel are O(1) and expired
+ * timer is delivered in batch grouped by target when the wheel is advanced.
+ *
+ * The wheel has kLevels level of kSlots slot, each level covering kSlots
+ * times the range of the one below it. Timer further than the top level
+ * range is parked in the top level and re-inserted on cascade.
+ */
+class TimerWheel {
+ public:
+  using clock_type = std::chrono::steady_clock;
+  using duration = clock_type::duration;
+  using time_point = clock_type::time_point;
+
+  static constexpr size_t kBits = 6;
+  static constexpr size_t kSlots = size_t(1) << kBits;
+  static constexpr size_t kLevels = 5;
+
+  explicit TimerWheel(duration tick = std::chrono::milliseconds(1),
+                      time_point start = clock_type::now())
+      : tick_duration_(std::max(tick, duration(1))), start_(start) {}
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  ~TimerWheel() {
+    for (auto& level : wheel_)
+      for (auto& slot : level)
+        while (slot.IsLinked()) Unlink(static_cast<Node*>(slot.next_));
+  }
+
+  /**
+   * @brief: Add node that expires after delay, and then every period if
+   * period is not zero
+   */
+  Timer Add(std::shared_ptr<detail::TimerNode> node, duration delay,
+            duration period = duration::zero()) {
+    auto raw = node.get();
+    Timer timer(this, node);
+
+    locker_type locker(mutex_);
+    raw->expire_ = tick_ + ToTick(delay);
+    raw->period_ = period > duration::zero() ? ToTick(period) : 0;
+    raw->self_ = std::move(node);
+    Insert(raw);
+    ++count_;
+
+    return timer;
+  }
+
+  /**
+   * @brief: Expire every timer due at now, and deliver them grouped by target.
+   * Periodic timer expires at most once per call.
+   *
+   * @return: number of timer expired
+   */
+  size_t Advance(time_point now = clock_type::now()) {
+    Node::batch_type expired;
+    {
+      locker_type locker(mutex_);
+      if (now < start_) return 0;
+      const uint64_t target = (now - start_) / tick_duration_;
+
+      while (tick_ < target && count_ != 0) {
+        ++tick_;
+        Cascade();
+        TakeSlot(wheel_[0][tick_ & kMask], expired);
+      }
+      tick_ = std::max(tick_, target);
+    }
+
+    if (expired.empty()) return 0;
+
+    std::stable_sort(expired.begin(), expired.end(),
+                     [](const auto& a, const auto& b) {
+                       return std::less<const void*>()(a->Target(),
+                                                       b->Target());
+                     });
+
+    for (auto first = expired.begin(); first != expired.end();) {
+      auto last = std::find_if(first, expired.end(), [&](const auto& node) {
+        return node->Target() != (*first)->Target();
+      });
+      (*first)->Deliver(first, last);
+      first = last;
+    }
+
+    Rearm(expired);
+    return expired.size();
+  }
+
+  /**
+   * @brief: Wheel resolution, Advance should be called at least this often
+   * while timer is pending
+   */
+  duration TickDuration() const noexcept { return tick_duration_; }
+
+  /**
+   * @brief: Time of the last processed tick
+   */
+  time_point Now() const {
+    locker_type locker(mutex_);
+    return start_ + tick_duration_ * static_cast<duration::rep>(tick_);
+  }
+
+  size_t Count() const {
+    locker_type locker(mutex_);
+    return count_;
+  }
+
+ private:
+  friend class Timer;
+  using Node = detail::TimerNode;
+  using Link = detail::TimerLink;
+  using locker_type = std::scoped_lock<std::mutex>;
+
+  static constexpr uint64_t kMask = kSlots - 1;
+
+  uint64_t ToTick(duration d) const noexcept {
+    // round up and never expire in the tick already processed
+    auto tick = (d + tick_duration_ - duration(1)) / tick_duration_;
+    return tick > 0 ? uint64_t(tick) : 1;
+  }
+
+  void Insert(Node* node) noexcept {
+    const uint64_t delta = node->expire_ > tick_ ? node->expire_ - tick_ : 0;
+
+    for (size_t level = 0; level < kLevels; ++level) {
+      if (delta < (uint64_t(1) << (kBits * (level + 1)))) {
+        auto idx = (node->expire_ >> (kBits * level)) & kMask;
+        wheel_[level][idx].PushBack(node);
+        return;
+      }
+    }
+
+    // beyond wheel range, park it at the far end of the top level
+    constexpr size_t top = kLevels - 1;
+    constexpr uint64_t range = uint64_t(1) << (kBits * kLevels);
+    auto idx = ((tick_ + range - 1) >> (kBits * top)) & kMask;
+    wheel_[top][idx].PushBack(node);
+  }
+
+  void Unlink(Node* node) noexcept {
+    node->Unlink();
+    node->self_.reset();
+  }
+
+  // move node of level whose lower level just wrapped into lower level
+  void Cascade() {
+    for (size_t level = 1; level < kLevels; ++level) {
+      if ((tick_ & ((uint64_t(1) << (kBits * level)) - 1)) != 0) return;
+
+      auto& slot = wheel_[level][(tick_ >> (kBits * level)) & kMask];
+      Link list;
+      while (slot.IsLinked()) {
+        auto node = slot.next_;
+        node->Unlink();
+        list.PushBack(node);
+      }
+      while (list.IsLinked()) {
+        auto node = static_cast<Node*>(list.next_);
+        node->Unlink();
+        Insert(node);
+      }
+    }
+  }
+
+  void TakeSlot(Link& slot, Node::batch_type& expired) {
+    while (slot.IsLinked()) {
+      auto node = static_cast<Node*>(slot.next_);
+      node->Unlink();
+      expired.push_back(std::move(node->self_));
+      --count_;
+    }
+  }
+
+  void Rearm(Node::batch_type& expired) {
+    locker_type locker(mutex_);
+    for (auto& node : expired) {
+      if (node->period_ == 0 || node->cancelled_) continue;
+
+      node->expire_ = std::max(node->expire_ + node->period_, tick_ + 1);
+      auto raw = node.get();
+      raw->self_ = std::move(node);
+      Insert(raw);
+      ++count_;
+    }
+  }
+
+  bool Cancel(const std::shared_ptr<Node>& node) noexcept {
+    locker_type locker(mutex_);
+    node->cancelled_ = true;
+    if (!node->self_) return false;
+
+    Unlink(node.get());
+    --count_;
+    return true;
+  }
+
+  bool IsPending(const std::shared_ptr<Node>& node) const noexcept {
+    locker_type locker(mutex_);
+    return !node->cancelled_ && (node->self_ || node->period_ != 0);
+  }
+
+  duration tick_duration_;
+  time_point start_;
+  uint64_t tick_ = 0;
+  size_t count_ = 0;
+  mutable std::mutex mutex_;
+  Link wheel_[kLevels][kSlots];
+};
+
+inline bool Timer::IsPending() const noexcept {
+  auto node = node_.lock();
+  return node && wheel_->IsPending(node);
+}
+
+inline bool Timer::Cancel() noexcept {
+  auto node = node_.lock();
+  return node && wheel_->Cancel(node);
+}
+
+}  // namespace evtsigslot
+
+#endif /* end of include guard: EVTSIGSLOT_TIMER_WHEEL */
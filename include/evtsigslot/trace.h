@@ -0,0 +1,329 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2021 Uskrai
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef EVTSIGSLOT_TRACER
+#define EVTSIGSLOT_TRACER
+
+#include <evtsigslot/binding.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Tracing hook is compiled in only when EVTSIGSLOT_TRACE is defined, the
+ * Tracer itself is always available to name object and flush the trace.
+ */
+#ifdef EVTSIGSLOT_TRACE
+#define EVTSIGSLOT_TRACE_SPAN(kind, object, owner)          \
+  ::evtsigslot::trace::Span evtsigslot_trace_span_##kind( \
+      ::evtsigslot::trace::Kind::kind, object, owner)
+#else
+#define EVTSIGSLOT_TRACE_SPAN(kind, object, owner)
+#endif
+
+namespace evtsigslot {
+
+namespace trace {
+
+enum class Kind : uint8_t {
+  // event queued, instant on the producer thread
+  kQueue,
+  // time between queue and drain of one event
+  kWait,
+  // one ProcessEvent call
+  kDrain,
+  // one slot call
+  kSlot
+};
+
+struct Record {
+  Kind kind;
+  // signal, or slot for kSlot
+  const void* object;
+  // signal of the slot for kSlot
+  const void* owner;
+  uint64_t begin, end;
+};
+
+/**
+ * @brief: Fixed size record buffer written only by its thread, a record is
+ * published by the release store of its size so Flush can read it from any
+ * thread. Record past the capacity is counted and dropped.
+ */
+class ThreadBuffer {
+ public:
+  static constexpr size_t kCapacity = size_t(1) << 16;
+
+  explicit ThreadBuffer(uint64_t tid)
+      : records_(new Record[kCapacity]), tid_(tid) {}
+
+  void Push(const Record& record) noexcept {
+    auto size = size_.load(std::memory_order_relaxed);
+    if (size == kCapacity) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    records_[size] = record;
+    size_.store(size + 1, std::memory_order_release);
+  }
+
+ private:
+  friend class Tracer;
+
+  std::unique_ptr<Record[]> records_;
+  std::atomic_size_t size_{0}, dropped_{0};
+  uint64_t tid_;
+};
+
+/**
+ * @brief: Process wide trace collector, write Chrome trace event JSON that
+ * can be opened in Perfetto or chrome://tracing
+ */
+class Tracer {
+ public:
+  static Tracer& Instance() {
+    static Tracer tracer;
+    return tracer;
+  }
+
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+
+  bool IsEnabled() const noexcept {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  void SetEnabled(bool enabled) noexcept {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  /**
+   * @return: nanosecond since the tracer was created
+   */
+  uint64_t Now() const noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               clock_type::now() - start_)
+        .count();
+  }
+
+  void Add(const Record& record) {
+    if (IsEnabled()) Local().Push(record);
+  }
+
+  /**
+   * @brief: Name shown for signal or slot instead of its address
+   */
+  void Name(const void* object, std::string name) {
+    locker_type locker(mutex_);
+    names_[object] = std::move(name);
+  }
+
+  void Name(const Binding& binding, std::string name) {
+    if (auto state = binding.state_.lock()) Name(state.get(), std::move(name));
+  }
+
+  size_t Dropped() const {
+    locker_type locker(mutex_);
+    size_t dropped = 0;
+    for (auto& buffer : buffers_) dropped += buffer->dropped_.load();
+    return dropped;
+  }
+
+  /**
+   * @brief: Forget every record, should not race with traced thread
+   */
+  void Clear() {
+    locker_type locker(mutex_);
+    for (auto& buffer : buffers_) {
+      buffer->size_.store(0);
+      buffer->dropped_.store(0);
+    }
+  }
+
+  /**
+   * @brief: Write every record published so far to path
+   * @return: false if the file can't be written
+   */
+  bool Flush(const std::string& path) const {
+    std::unique_ptr<FILE, int (*)(FILE*)> file(std::fopen(path.c_str(), "w"),
+                                               &std::fclose);
+    if (!file) return false;
+
+    locker_type locker(mutex_);
+    std::string out = "{\"traceEvents\":[\n";
+    uint64_t wait_id = 0;
+    bool first = true;
+    auto next = [&] {
+      if (!first) out += ",\n";
+      first = false;
+    };
+
+    for (auto& buffer : buffers_) {
+      const auto tid = std::to_string(buffer->tid_);
+      next();
+      out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid +
+             ",\"args\":{\"name\":\"thread " + tid + "\"}}";
+
+      const auto size = buffer->size_.load(std::memory_order_acquire);
+      for (size_t i = 0; i < size; ++i) {
+        const auto& record = buffer->records_[i];
+        const auto common = ",\"pid\":1,\"tid\":" + tid +
+                            ",\"ts\":" + Micro(record.begin);
+
+        next();
+        switch (record.kind) {
+          case Kind::kQueue:
+            out += "{\"name\":\"queue " + NameOf(record.object) +
+                   "\",\"cat\":\"queue\",\"ph\":\"i\",\"s\":\"t\"" + common +
+                   "}";
+            break;
+          case Kind::kWait: {
+            const auto id = std::to_string(++wait_id);
+            const auto name = NameOf(record.object);
+            out += "{\"name\":\"" + name +
+                   "\",\"cat\":\"queue-wait\",\"ph\":\"b\",\"id\":" + id +
+                   common + "},\n";
+            out += "{\"name\":\"" + name +
+                   "\",\"cat\":\"queue-wait\",\"ph\":\"e\",\"id\":" + id +
+                   ",\"pid\":1,\"tid\":" + tid +
+                   ",\"ts\":" + Micro(record.end) + "}";
+            break;
+          }
+          case Kind::kDrain:
+            out += "{\"name\":\"drain " + NameOf(record.object) +
+                   "\",\"cat\":\"drain\",\"ph\":\"X\"" + common +
+                   ",\"dur\":" + Micro(record.end - record.begin) + "}";
+            break;
+          case Kind::kSlot:
+            out += "{\"name\":\"" + NameOf(record.object) +
+                   "\",\"cat\":\"slot\",\"ph\":\"X\"" + common +
+                   ",\"dur\":" + Micro(record.end - record.begin) +
+                   ",\"args\":{\"signal\":\"" + NameOf(record.owner) + "\"}}";
+            break;
+        }
+      }
+    }
+    out += "\n]}\n";
+
+    return std::fwrite(out.data(), 1, out.size(), file.get()) == out.size();
+  }
+
+ private:
+  using clock_type = std::chrono::steady_clock;
+  using locker_type = std::scoped_lock<std::mutex>;
+
+  Tracer() : start_(clock_type::now()) {}
+
+  // buffer is shared so it can still be flushed after its thread exits
+  ThreadBuffer& Local() {
+    thread_local std::shared_ptr<ThreadBuffer> local;
+    if (!local) {
+      locker_type locker(mutex_);
+      local = std::make_shared<ThreadBuffer>(buffers_.size() + 1);
+      buffers_.push_back(local);
+    }
+    return *local;
+  }
+
+  // should be called with mutex_ held
+  std::string NameOf(const void* object) const {
+    auto it = names_.find(object);
+    if (it != names_.end()) return Escape(it->second);
+
+    char address[2 * sizeof(void*) + 3];
+    std::snprintf(address, sizeof(address), "%p", object);
+    return address;
+  }
+
+  static std::string Micro(uint64_t ns) {
+    char micro[32];
+    std::snprintf(micro, sizeof(micro), "%llu.%03u",
+                  static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned>(ns % 1000));
+    return micro;
+  }
+
+  static std::string Escape(const std::string& name) {
+    std::string ret;
+    for (char c : name) {
+      if (c == '"' || c == '\\') {
+        ret += '\\';
+        ret += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        char code[7];
+        std::snprintf(code, sizeof(code), "\\u%04x", c);
+        ret += code;
+      } else {
+        ret += c;
+      }
+    }
+    return ret;
+  }
+
+  const clock_type::time_point start_;
+  std::atomic_bool enabled_{true};
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+  std::unordered_map<const void*, std::string> names_;
+};
+
+/**
+ * @brief: Record the lifetime of this object as one span
+ */
+class Span {
+ public:
+  Span(Kind kind, const void* object, const void* owner = nullptr) noexcept
+      : kind_(kind),
+        object_(object),
+        owner_(owner),
+        begin_(Tracer::Instance().Now()) {}
+
+  ~Span() {
+    auto& tracer = Tracer::Instance();
+    tracer.Add({kind_, object_, owner_, begin_, tracer.Now()});
+  }
+
+  Span(const Span&) = delete;
+  Span& operator=(const Span&) = delete;
+
+ private:
+  Kind kind_;
+  const void* object_;
+  const void* owner_;
+  uint64_t begin_;
+};
+
+}  // namespace trace
+
+}  // namespace evtsigslot
+
+#endif /* end of include guard: EVTSIGSLOT_TRACER */
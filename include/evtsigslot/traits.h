@@ -25,6 +25,7 @@
 #ifndef EVTSIGSLOT_TRAITS
 #define EVTSIGSLOT_TRAITS
 
+#include <memory>
 #include <type_traits>
 
 namespace evtsigslot {
@@ -35,6 +36,17 @@ struct observer_type {};
 
 }  // namespace detail
 
+/// shared_ptr and weak_ptr binded object is tracked through a weak_ptr
+template <typename T>
+std::weak_ptr<T> to_weak(std::weak_ptr<T> w) {
+  return w;
+}
+
+template <typename T>
+std::weak_ptr<T> to_weak(std::shared_ptr<T> s) {
+  return s;
+}
+
 namespace trait {
 
 /// represent a list of types
@@ -60,12 +72,44 @@ struct has_call_operator<
     F, void_t<decltype(&std::remove_reference<F>::type::operator())>>
     : std::true_type {};
 
+template <typename T, typename = void>
+struct is_weak_ptr : std::false_type {};
+
+template <typename T>
+struct is_weak_ptr<T, void_t<decltype(std::declval<T>().expired()),
+                             decltype(std::declval<T>().lock()),
+                             decltype(std::declval<T>().reset())>>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct is_weak_ptr_compatible : std::false_type {};
+
+template <typename T>
+struct is_weak_ptr_compatible<T, void_t<decltype(to_weak(std::declval<T>()))>>
+    : is_weak_ptr<decltype(to_weak(std::declval<T>()))> {};
+
+// tracked object is called through the locked pointer
+template <typename P, typename = void>
+struct tracked_pointer {
+  using type = P;
+};
+
+template <typename P>
+struct tracked_pointer<
+    P, std::enable_if_t<is_weak_ptr_compatible<std::decay_t<P>>::value>> {
+  using type = decltype(to_weak(std::declval<P>()).lock());
+};
+
+template <typename P>
+using tracked_pointer_t = typename tracked_pointer<P>::type;
+
 template <typename, typename, typename = void, typename = void>
 struct is_callable : std::false_type {};
 
 template <typename F, typename P, typename... T>
 struct is_callable<F, P, typelist<T...>,
-                   void_t<decltype(((*std::declval<P>()).*std::declval<F>())(
+                   void_t<decltype(((*std::declval<tracked_pointer_t<P>>()).*
+                                    std::declval<F>())(
                        std::declval<T>()...))>> : std::true_type {};
 
 template <typename F, typename... T>
@@ -79,7 +123,8 @@ struct is_slot_callable : std::false_type {};
 template <typename Callable, typename Pointer, typename... T>
 struct is_slot_callable<
     Callable, Pointer, typelist<T...>,
-    void_t<decltype(((*std::declval<Pointer>()).*std::declval<Callable>())(
+    void_t<decltype(((*std::declval<tracked_pointer_t<Pointer>>()).*
+                     std::declval<Callable>())(
         std::declval<std::add_lvalue_reference_t<T>>()...))>> : std::true_type {
 };
 
@@ -90,22 +135,6 @@ struct is_slot_callable<
         std::declval<std::add_lvalue_reference_t<T>>()...))>> : std::true_type {
 };
 
-template <typename T, typename = void>
-struct is_weak_ptr : std::false_type {};
-
-template <typename T>
-struct is_weak_ptr<T, void_t<decltype(std::declval<T>().expired()),
-                             decltype(std::declval<T>().lock()),
-                             decltype(std::declval<T>().reset())>>
-    : std::true_type {};
-
-template <typename T, typename = void>
-struct is_weak_ptr_compatible : std::false_type {};
-
-template <typename T>
-struct is_weak_ptr_compatible<T, void_t<decltype(to_weak(std::declval<T>()))>>
-    : is_weak_ptr<decltype(to_weak(std::declval<T>()))> {};
-
 }  // namespace detail
 
 static constexpr bool with_rtti =
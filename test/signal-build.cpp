@@ -0,0 +1,56 @@
+#include <evtsigslot/signal.h>
+
+#include <string>
+
+// compiled by the build-time target only, every Bind site below resolves its
+// slot type through slot_traits like a user translation unit would
+
+struct Widget {
+  void OnInt(int) {}
+  void OnEvent(evtsigslot::Event<int>&) {}
+  void OnString(const std::string&) {}
+  void OnVoid() {}
+};
+
+template <int N>
+struct Handler {
+  void operator()(int& i) const { i += N; }
+};
+
+#define EVTSIGSLOT_BUILD_SITES(N)                                      \
+  ints.Bind([](int i) { (void)(i + (N)); });                           \
+  ints.Bind([](evtsigslot::Event<int>& e) { (void)(e.Get() + (N)); }); \
+  ints.Bind([] { (void)(N); });                                        \
+  ints.Bind(Handler<N>{});                                             \
+  ints.Bind(&Widget::OnInt, &widget);                                  \
+  ints.Bind(&Widget::OnEvent, shared);                                 \
+  strings.Bind([](const std::string& s) { (void)(s.size() + (N)); });  \
+  strings.Bind(&Widget::OnString, &widget);                            \
+  voids.Bind([] { (void)(N); });                                       \
+  voids.Bind(&Widget::OnVoid, shared);
+
+#define EVTSIGSLOT_BUILD_SITES_4(N) \
+  EVTSIGSLOT_BUILD_SITES(N)         \
+  EVTSIGSLOT_BUILD_SITES(N + 1)     \
+  EVTSIGSLOT_BUILD_SITES(N + 2)     \
+  EVTSIGSLOT_BUILD_SITES(N + 3)
+
+#define EVTSIGSLOT_BUILD_SITES_16(N) \
+  EVTSIGSLOT_BUILD_SITES_4(N)        \
+  EVTSIGSLOT_BUILD_SITES_4(N + 4)    \
+  EVTSIGSLOT_BUILD_SITES_4(N + 8)    \
+  EVTSIGSLOT_BUILD_SITES_4(N + 12)
+
+void build_sites() {
+  Widget widget;
+  auto shared = std::make_shared<Widget>();
+  evtsigslot::Signal<int> ints;
+  evtsigslot::Signal<std::string> strings;
+  evtsigslot::Signal<void> voids;
+
+  EVTSIGSLOT_BUILD_SITES_16(0)
+
+  ints(1);
+  strings("build");
+  voids();
+}
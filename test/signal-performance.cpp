@@ -1,10 +1,44 @@
+#include <evtsigslot/keyed_signal.h>
+#include <evtsigslot/routed_signal.h>
 #include <evtsigslot/signal.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <thread>
 #include <vector>
 
+// heap allocation made by the test, only counted by test_memory_performance
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+  ++allocations;
+  if (auto ptr = std::malloc(size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t align) {
+  ++allocations;
+  const auto alignment = static_cast<size_t>(align);
+  size = (size + alignment - 1) / alignment * alignment;
+  if (auto ptr = std::aligned_alloc(alignment, size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
 void test_signal_performance() {
   using Clock = std::chrono::high_resolution_clock;
   using TimePoint = std::chrono::time_point<Clock>;
@@ -45,7 +79,666 @@ void test_signal_performance() {
   assert(delta < max_delta);
 }
 
+void test_forward_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int depth = 16;
+  constexpr int count = 10000;
+
+  auto measure = [&](bool forward) {
+    std::vector<evtsigslot::Signal<int>> chain(depth);
+    int sum = 0;
+    for (int i = 0; i + 1 < depth; ++i) {
+      if (forward)
+        chain[i].Forward(chain[i + 1]);
+      else
+        chain[i].Bind([&, i](int v) { chain[i + 1](v); });
+    }
+    chain.back().Bind([&](int v) { sum += v; });
+
+    const auto begin = Clock::now();
+    for (int i = 0; i < count; ++i) chain.front()(1);
+    const double ns =
+        double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   Clock::now() - begin)
+                   .count());
+    assert(sum == count);
+    return ns;
+  };
+
+  const double relay_ns = measure(false);
+  const double forward_ns = measure(true);
+
+  std::cout << "relay: " << relay_ns / count << " ns/emit" << std::endl;
+  std::cout << "forward: " << forward_ns / count << " ns/emit" << std::endl;
+
+  assert(forward_ns < relay_ns);
+}
+
+void test_keyed_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int keys = 10000;
+  constexpr int count = 1000;
+  int sum = 0;
+
+  evtsigslot::Signal<std::pair<int, int>> flat;
+  evtsigslot::KeyedSignal<int, int> keyed;
+  for (int key = 0; key < keys; ++key) {
+    flat.Bind([&, key](std::pair<int, int>& msg) {
+      if (msg.first == key) sum += msg.second;
+    });
+    keyed.Bind(key, [&](int v) { sum += v; });
+  }
+
+  auto begin = Clock::now();
+  for (int i = 0; i < count; ++i) flat(i % keys, 1);
+  const auto flat_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           Clock::now() - begin)
+                           .count();
+
+  begin = Clock::now();
+  for (int i = 0; i < count; ++i) keyed(i % keys, 1);
+  const auto keyed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - begin)
+                            .count();
+
+  std::cout << "flat topic: " << flat_ns / count << " ns/emit" << std::endl;
+  std::cout << "keyed topic: " << keyed_ns / count << " ns/emit" << std::endl;
+
+  assert(sum == 2 * count);
+  assert(keyed_ns < flat_ns);
+}
+
+void test_routed_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int slots = 1000;
+  int sum = 0;
+
+  // every slot matches its own window, so the index has a cell per bound
+  auto value = [](const int& v) { return v; };
+  evtsigslot::RoutedSignal<int, decltype(value)> routed(value);
+  std::vector<evtsigslot::Binding> bindings;
+
+  auto begin = Clock::now();
+  for (int i = 0; i < slots; ++i)
+    bindings.push_back(
+        routed.Bind(evtsigslot::Between(i, i + 8), [&] { ++sum; }));
+  // the index is only built by the first emission
+  routed(0);
+  const auto bind_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           Clock::now() - begin)
+                           .count();
+
+  for (int i = 1; i < slots; ++i) routed(i);
+  assert(sum == 8 * slots - 28);
+
+  begin = Clock::now();
+  for (auto& bind : bindings) bind.Unbind();
+  const auto unbind_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                           begin)
+          .count();
+
+  std::cout << "routed bind: " << bind_ns / slots << " ns/slot" << std::endl;
+  std::cout << "routed unbind: " << unbind_ns / slots << " ns/slot"
+            << std::endl;
+
+  assert(routed.CountSlot() == 0);
+}
+
+struct listener {
+  void on(int) {}
+};
+
+struct observer : evtsigslot::Observer {
+  ~observer() { UnbindAll(); }
+  void on(int) {}
+};
+
+void test_observer_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int signals = 200;
+  constexpr int others = 1000;
+
+  std::vector<evtsigslot::Signal<int>> sig(signals);
+  for (auto& it : sig)
+    for (int i = 0; i < others; ++i) it.Bind([](int) {});
+
+  listener l;
+  auto o = std::make_unique<observer>();
+  for (auto& it : sig) {
+    it.Bind(&listener::on, &l);
+    it.Bind(&observer::on, o.get());
+  }
+
+  // both are timed through the next emission, the observer slot are only
+  // removed from the list by the drain that follows, with the same scan of
+  // the list unbinding by object does, so neither is expected to be faster
+  auto begin = Clock::now();
+  for (auto& it : sig) {
+    it.Unbind(&l);
+    it(1);
+  }
+  const auto scan_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           Clock::now() - begin)
+                           .count();
+
+  begin = Clock::now();
+  o.reset();
+  for (auto& it : sig) it(1);
+  const auto observer_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                           begin)
+          .count();
+
+  std::cout << "unbind by object: " << scan_ns / signals << " ns/signal"
+            << std::endl;
+  std::cout << "observer destroy: " << observer_ns / signals << " ns/signal"
+            << std::endl;
+
+  for (auto& it : sig) {
+    auto stats = it.Stats();
+    assert(stats.slots == others && stats.expired == 0);
+  }
+}
+
+void test_binding_id_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int count = 10000;
+  constexpr int rounds = 20;
+
+  evtsigslot::Signal<int> sig;
+  std::vector<evtsigslot::Binding> bindings;
+  std::vector<evtsigslot::BindingId> ids;
+  for (int i = 0; i < count; ++i) {
+    bindings.push_back(sig.Bind([](int) {}));
+    ids.push_back(sig.BindId([](int) {}));
+  }
+
+  size_t binded = 0;
+  auto begin = Clock::now();
+  for (int r = 0; r < rounds; ++r)
+    for (auto& it : bindings) {
+      it.Block();
+      binded += it.IsBinded();
+      it.Unblock();
+    }
+  const auto binding_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              Clock::now() - begin)
+                              .count();
+
+  begin = Clock::now();
+  for (int r = 0; r < rounds; ++r)
+    for (auto& it : ids) {
+      sig.Block(it);
+      binded += sig.IsBinded(it);
+      sig.Unblock(it);
+    }
+  const auto id_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         Clock::now() - begin)
+                         .count();
+
+  std::cout << "Binding (" << sizeof(evtsigslot::Binding)
+            << " bytes): " << binding_ns / (count * rounds) << " ns/op"
+            << std::endl;
+  std::cout << "BindingId (" << sizeof(evtsigslot::BindingId)
+            << " bytes): " << id_ns / (count * rounds) << " ns/op" << std::endl;
+
+  // timing depends on optimization, the handle itself is always smaller
+  assert(binded == 2 * count * rounds);
+  assert(sizeof(evtsigslot::BindingId) < sizeof(evtsigslot::Binding));
+}
+
+void test_blocked_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int slots = 10000;
+  constexpr int count = 100;
+  int sum = 0;
+
+  evtsigslot::Signal<int> live, blocked, blocked_id;
+  for (int i = 0; i < slots; ++i) {
+    live.Bind([&](int v) { sum += v; });
+    auto bind = blocked.Bind([&](int v) { sum += v; });
+    auto id = blocked_id.BindId([&](int v) { sum += v; });
+    if (i % 1000 != 0) {
+      bind.Block();
+      blocked_id.Block(id);
+    }
+  }
+
+  auto begin = Clock::now();
+  for (int i = 0; i < count; ++i) live(1);
+  const auto live_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           Clock::now() - begin)
+                           .count();
+
+  begin = Clock::now();
+  for (int i = 0; i < count; ++i) blocked(1);
+  const auto blocked_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              Clock::now() - begin)
+                              .count();
+
+  // slot blocked by id is skipped through the mask too
+  begin = Clock::now();
+  for (int i = 0; i < count; ++i) blocked_id(1);
+  const auto blocked_id_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                           begin)
+          .count();
+
+  std::cout << "all live: " << live_ns / count << " ns/emit" << std::endl;
+  std::cout << "mostly blocked: " << blocked_ns / count << " ns/emit"
+            << std::endl;
+  std::cout << "mostly blocked by id: " << blocked_id_ns / count
+            << " ns/emit" << std::endl;
+
+  assert(sum == (slots + 2 * (slots / 1000)) * count);
+  assert(blocked_ns * 10 < live_ns);
+  assert(blocked_id_ns * 10 < live_ns);
+}
+
+void test_reentrancy_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int hops = 2000;
+  std::vector<std::unique_ptr<evtsigslot::Signal<int>>> chain;
+  for (int i = 0; i < hops; ++i)
+    chain.push_back(std::make_unique<evtsigslot::Signal<int>>());
+
+  const char* top = nullptr;
+  const char* bottom = nullptr;
+  int last = 0;
+  for (int i = 0; i < hops; ++i) {
+    chain[i]->Bind([&, i](int val) {
+      char marker;
+      if (!top) top = bottom = &marker;
+      bottom = std::min<const char*>(bottom, &marker);
+      if (i + 1 < hops)
+        (*chain[i + 1])(val + 1);
+      else
+        last = val;
+    });
+  }
+
+  auto measure = [&](const char* name, size_t depth) {
+    for (auto& sig : chain) sig->SetMaxDepth(depth);
+    top = bottom = nullptr;
+
+    const auto begin = Clock::now();
+    (*chain[0])(0);
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::now() - begin)
+                        .count();
+    assert(last == hops - 1);
+
+    const size_t stack = top - bottom;
+    std::cout << name << ": " << ns / hops << " ns/hop, " << stack
+              << " stack byte" << std::endl;
+    return stack;
+  };
+
+  const auto inline_stack = measure("inline", hops);
+  const auto bounded_stack = measure("max depth 64", 64);
+  const auto deferred_stack = measure("max depth 1", 1);
+
+  assert(bounded_stack * 10 < inline_stack);
+  assert(deferred_stack < bounded_stack);
+}
+
+void test_memory_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+  using signal_type = evtsigslot::Signal<int>;
+
+  constexpr size_t count = 1000000;
+  int sum = 0;
+
+  if constexpr (sizeof(void*) == 8)
+    static_assert(sizeof(signal_type) <= signal_type::kSizeBudget);
+
+  auto begin = Clock::now();
+  allocations = 0;
+  std::unique_ptr<signal_type[]> signals(new signal_type[count]);
+  const auto construct_alloc = allocations;
+  const auto construct_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                           begin)
+          .count();
+
+  allocations = 0;
+  for (size_t i = 0; i < count; ++i)
+    signals[i].Bind([&](int v) { sum += v; });
+  const auto bind_alloc = allocations;
+
+  allocations = 0;
+  for (size_t i = 0; i < count; ++i) signals[i](1);
+  const auto emit_alloc = allocations;
+
+  begin = Clock::now();
+  signals.reset();
+  const auto destroy_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              Clock::now() - begin)
+                              .count();
+
+  std::cout << "sizeof(Signal<int>): " << sizeof(signal_type) << " byte"
+            << std::endl;
+  std::cout << "construct: " << construct_ns / count << " ns, "
+            << (construct_alloc - 1) / double(count) << " alloc/signal"
+            << std::endl;
+  std::cout << "first bind: " << bind_alloc / double(count)
+            << " alloc/signal" << std::endl;
+  std::cout << "first emit: " << emit_alloc / double(count)
+            << " alloc/signal" << std::endl;
+  std::cout << "destroy: " << destroy_ns / count << " ns" << std::endl;
+
+  assert(sum == int(count));
+  // only the array itself
+  assert(construct_alloc == 1);
+}
+
+// binding one more slot should not cost more as the signal grows
+void test_bind_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  auto run = [](int slots) {
+    evtsigslot::Signal<int> sig;
+    auto begin = Clock::now();
+    for (int i = 0; i < slots; ++i) sig.Bind([](int) {});
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::now() - begin)
+                        .count();
+    assert(sig.CountSlot() == size_t(slots));
+    return ns / slots;
+  };
+
+  // warm up the allocator first
+  run(1000);
+  const auto small = run(1000);
+  const auto large = run(16000);
+  std::cout << "bind: " << small << " ns/slot at 1000 slot, " << large
+            << " ns/slot at 16000 slot" << std::endl;
+
+  // a copy of the list per bind would be 16 times slower
+  assert(large < 4 * small + 100);
+}
+
+void test_resource_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int frames = 2000;
+  constexpr int slots = 16;
+  constexpr int events = 64;
+  int sum = 0;
+
+  // every frame builds a signal, binds and emits, then throws it all away
+  auto frame = [&](std::pmr::memory_resource* resource) {
+    evtsigslot::Signal<int> sig(resource);
+    for (int i = 0; i < slots; ++i) sig.Bind([&](int v) { sum += v; });
+    for (int i = 0; i < events; ++i) sig(1);
+  };
+
+  allocations = 0;
+  auto begin = Clock::now();
+  for (int i = 0; i < frames; ++i) frame(std::pmr::new_delete_resource());
+  const auto heap_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           Clock::now() - begin)
+                           .count();
+  const auto heap_alloc = allocations;
+
+  std::vector<std::byte> buffer(1 << 20);
+  allocations = 0;
+  begin = Clock::now();
+  for (int i = 0; i < frames; ++i) {
+    // nothing should fall back to the upstream resource
+    std::pmr::monotonic_buffer_resource arena(
+        buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    frame(&arena);
+  }
+  const auto arena_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - begin)
+                            .count();
+  const auto arena_alloc = allocations;
+
+  std::cout << "global heap: " << heap_ns / frames << " ns/frame, "
+            << heap_alloc / frames << " alloc/frame" << std::endl;
+  std::cout << "monotonic arena: " << arena_ns / frames << " ns/frame, "
+            << arena_alloc / frames << " alloc/frame" << std::endl;
+
+  assert(sum == 2 * frames * slots * events);
+  assert(arena_alloc == 0);
+}
+
+void test_contention_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int producers = 3;
+  constexpr int count = 100000;
+
+  evtsigslot::EventLoop loop;
+  evtsigslot::Signal<int> sig;
+  int sum = 0;
+  auto id = sig.BindId([&](int v) { sum += v; });
+  sig.Attach(loop);
+
+  // reader only touch the read mostly line of the signal while producer
+  // write the queue line
+  auto read = [&](std::atomic_bool& run) {
+    size_t reads = 0, binded = 0;
+    const auto begin = Clock::now();
+    while (run.load(std::memory_order_relaxed) || reads < 1000) {
+      binded += sig.IsBinded(id) && !sig.IsBlocked(id);
+      ++reads;
+    }
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::now() - begin)
+                        .count();
+    assert(binded == reads);
+    return double(ns) / reads;
+  };
+
+  std::atomic_bool run{false};
+  const auto alone_ns = read(run);
+
+  run = true;
+  double contended_ns = 0;
+  std::thread reader([&] { contended_ns = read(run); });
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+    threads.emplace_back([&] {
+      for (int i = 0; i < count; ++i) sig(1);
+    });
+  for (auto& t : threads) t.join();
+  run = false;
+  reader.join();
+  loop.ProcessPending();
+
+  std::cout << "sizeof(Signal<int>): " << sizeof(sig)
+            << " byte, queue state on its own cache line" << std::endl;
+  std::cout << "reader alone: " << alone_ns << " ns/read" << std::endl;
+  std::cout << "reader with " << producers
+            << " producer: " << contended_ns << " ns/read" << std::endl;
+
+  assert(sum == producers * count);
+
+  // dispatch reads the state of every live slot, so its size decides the
+  // line walked over a list larger than the cache. performance-packed runs
+  // the same with EVTSIGSLOT_CACHE_LINE=0, dropping every padding
+  constexpr int wide_slots = 10000;
+  constexpr int wide_emits = 200;
+  evtsigslot::Signal<int> wide;
+  for (int i = 0; i < wide_slots; ++i) wide.Bind([&](int v) { sum += v; });
+  const auto wide_begin = Clock::now();
+  for (int i = 0; i < wide_emits; ++i) wide(1);
+  const auto wide_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           Clock::now() - wide_begin)
+                           .count();
+
+  std::cout << "slot state " << sizeof(evtsigslot::detail::SlotState)
+            << " byte (cache line " << EVTSIGSLOT_CACHE_LINE
+            << "), dispatch over " << wide_slots
+            << " slot: " << double(wide_ns) / (wide_slots * wide_emits)
+            << " ns/slot" << std::endl;
+
+  assert(sum == producers * count + wide_slots * wide_emits);
+}
+
+void test_shard_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int count = 50000;
+  const int most = std::max(2, int(std::thread::hardware_concurrency()));
+
+  // producer queue while one drainer empties the signal, timed until the
+  // last event is dispatched
+  auto produce = [&](int producers,
+                     std::optional<evtsigslot::ShardOrder> order) {
+    evtsigslot::EventLoop loop;
+    evtsigslot::Signal<int> sig;
+    std::atomic<int64_t> sum{0};
+    sig.Bind([&](int v) { sum.fetch_add(v, std::memory_order_relaxed); });
+    if (order) sig.SetShards(size_t(producers), *order);
+    sig.Attach(loop);
+
+    const int64_t total = int64_t(producers) * count;
+    const auto begin = Clock::now();
+    std::thread drainer([&] {
+      while (sum.load(std::memory_order_relaxed) != total)
+        loop.ProcessPending();
+    });
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+      threads.emplace_back([&] {
+        for (int i = 0; i < count; ++i) sig(1);
+      });
+    for (auto& t : threads) t.join();
+    drainer.join();
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::now() - begin)
+                        .count();
+
+    assert(sum == total);
+    return double(ns) / total;
+  };
+
+  for (int producers = 1; producers <= most; producers *= 2) {
+    const auto single_ns = produce(producers, std::nullopt);
+    const auto producer_ns =
+        produce(producers, evtsigslot::ShardOrder::kProducer);
+    const auto emission_ns =
+        produce(producers, evtsigslot::ShardOrder::kEmission);
+    std::cout << producers << " producer, single queue: " << single_ns
+              << " ns/event, sharded by producer: " << producer_ns
+              << " ns/event, by emission: " << emission_ns << " ns/event"
+              << std::endl;
+  }
+}
+
+void test_combiner_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int slots = 16;
+  constexpr int rounds = 20000;
+
+  // slot i handles value i, older slot is asked last
+  evtsigslot::Signal<int> skip;
+  evtsigslot::Signal<int, std::optional<int>> emit;
+  std::optional<int> handled;
+  for (int i = 0; i < slots; ++i) {
+    skip.Bind([&, i](evtsigslot::Event<int>& event) {
+      if (event.Get() != i) return event.Skip();
+      handled = i;
+    });
+    emit.Bind([i](int v) { return v == i ? std::optional(i) : std::nullopt; });
+  }
+
+  int sum = 0;
+  auto begin = Clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    handled.reset();
+    evtsigslot::Event<int> event(r % slots);
+    skip.PostEvent(event);
+    sum += *handled;
+  }
+  const auto skip_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           Clock::now() - begin)
+                           .count();
+
+  begin = Clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    auto first = emit.Emit(
+        evtsigslot::FirstNonEmpty<std::optional<int>>{}, r % slots);
+    sum -= *first.value;
+  }
+  const auto emit_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           Clock::now() - begin)
+                           .count();
+
+  std::cout << "first handler by Skip: " << skip_ns / rounds
+            << " ns/emit, by FirstNonEmpty: " << emit_ns / rounds
+            << " ns/emit" << std::endl;
+
+  assert(sum == 0);
+}
+
+void test_veto_performance() {
+  using Clock = std::chrono::high_resolution_clock;
+
+  constexpr int groups = 16;
+  constexpr int rounds = 20000;
+
+  // the newest slot of group 0 captures the event, the other group only
+  // skip it
+  auto run = [&](bool veto) {
+    evtsigslot::Signal<int> sig;
+    int called = 0;
+    for (int group = 0; group < groups; ++group)
+      sig.BindGroup(group, [&](evtsigslot::Event<int>& event) {
+        ++called;
+        event.Skip();
+      });
+    sig.BindGroup(0, [&, veto](evtsigslot::Event<int>& event) {
+      ++called;
+      if (veto) event.Veto();
+    });
+
+    auto begin = Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+      evtsigslot::Event<int> event(r);
+      sig.PostEvent(event);
+    }
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now() - begin)
+                  .count();
+    assert(called == rounds * (veto ? 1 : groups));
+    return ns / rounds;
+  };
+
+  const auto consume = run(false);
+  const auto veto = run(true);
+  std::cout << "captured in group 0 of " << groups
+            << ", by not skipping: " << consume
+            << " ns/event, by Veto: " << veto << " ns/event" << std::endl;
+}
+
 int main() {
   test_signal_performance();
+  test_forward_performance();
+  test_keyed_performance();
+  test_routed_performance();
+  test_observer_performance();
+  test_binding_id_performance();
+  test_blocked_performance();
+  test_reentrancy_performance();
+  test_memory_performance();
+  test_bind_performance();
+  test_resource_performance();
+  test_contention_performance();
+  test_shard_performance();
+  test_combiner_performance();
+  test_veto_performance();
   return 0;
 }
@@ -1,9 +1,15 @@
+#include <evtsigslot/keyed_signal.h>
+#include <evtsigslot/routed_signal.h>
 #include <evtsigslot/signal.h>
 
 #include <cassert>
 #include <cmath>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <vector>
 
 static int sum = 0;
 
@@ -54,6 +60,46 @@ struct o8 {
   void operator()(int i) const volatile noexcept { sum += i; }
 };
 
+void test_reentrancy() {
+  sum = 0;
+  constexpr int n = 1000;
+  std::vector<std::unique_ptr<evtsigslot::Signal<int>>> chain;
+  for (int i = 0; i < n; ++i)
+    chain.push_back(std::make_unique<evtsigslot::Signal<int>>());
+
+  size_t deepest = 0;
+  std::vector<int> order;
+  for (int i = 0; i < n; ++i) {
+    chain[i]->SetMaxDepth(8);
+    chain[i]->Bind([&, i](int val) {
+      deepest = std::max(deepest, evtsigslot::detail::Trampoline::Depth());
+      order.push_back(val);
+      if (i + 1 < n)
+        (*chain[i + 1])(val + 1);
+      else
+        sum += val;
+    });
+  }
+
+  (*chain[0])(0);
+  assert(sum == n - 1);
+  assert(deepest == 8);
+  assert(evtsigslot::detail::Trampoline::Depth() == 0);
+  for (int i = 0; i < n; ++i) assert(order[i] == i);
+
+  auto stats = chain[8]->Stats();
+  assert(stats.deferred == 1 && stats.deepest == 1);
+  assert(chain[7]->Stats().deepest == 8);
+  assert(chain[0]->Stats().deferred == 0);
+
+  // drain deferred within a deferred drain is run by the same loop
+  for (auto& sig : chain) sig->SetMaxDepth(1);
+  deepest = 0;
+  order.clear();
+  (*chain[0])(0);
+  assert(sum == 2 * (n - 1) && deepest == 1 && order.size() == n);
+}
+
 void test_slot_count() {
   evtsigslot::Signal<int> sig;
   s p;
@@ -424,20 +470,20 @@ void test_disconnection_by_object() {
   }
 
   // disconnect by shared pointer
-  // {
-  // sum = 0;
-  // evtsigslot::Signal<int> sig;
-  // auto p1 = std::make_shared<s>();
-  // s p2;
-  //
-  // sig.Bind(&s::f1, p1);
-  // sig.Bind(&s::f2, &p2);
-  // sig(1);
-  // assert(sum == 2);
-  // sig.Unbind(p1);
-  // sig(1);
-  // assert(sum == 3);
-  // }
+  {
+    sum = 0;
+    evtsigslot::Signal<int> sig;
+    auto p1 = std::make_shared<s>();
+    s p2;
+
+    sig.Bind(&s::f1, p1);
+    sig.Bind(&s::f2, &p2);
+    sig(1);
+    assert(sum == 2);
+    sig.Unbind(p1);
+    sig(1);
+    assert(sum == 3);
+  }
 }
 
 void test_disconnection_by_object_and_pmf() {
@@ -459,22 +505,22 @@ void test_disconnection_by_object_and_pmf() {
   }
 
   // disconnect by shared pointer
-  // {
-  // sum = 0;
-  // evtsigslot::Signal<int> sig;
-  // auto p1 = std::make_shared<s>();
-  // auto p2 = std::make_shared<s>();
-  //
-  // sig.Bind(&s::f1, p1);
-  // sig.Bind(&s::f1, p2);
-  // sig.Bind(&s::f2, p1);
-  // sig.Bind(&s::f2, p2);
-  // sig(1);
-  // assert(sum == 4);
-  // // sig.Unbind(&s::f1, p2);
-  // sig(1);
-  // assert(sum == 7);
-  // }
+  {
+    sum = 0;
+    evtsigslot::Signal<int> sig;
+    auto p1 = std::make_shared<s>();
+    auto p2 = std::make_shared<s>();
+
+    sig.Bind(&s::f1, p1);
+    sig.Bind(&s::f1, p2);
+    sig.Bind(&s::f2, p1);
+    sig.Bind(&s::f2, p2);
+    sig(1);
+    assert(sum == 4);
+    sig.Unbind(&s::f1, p2);
+    sig(1);
+    assert(sum == 7);
+  }
 
   // disconnect by tracker
   // {
@@ -494,6 +540,292 @@ void test_disconnection_by_object_and_pmf() {
   // }
 }
 
+void test_tracked_lifetime() {
+  // shared pointer is tracked weakly
+  {
+    sum = 0;
+    evtsigslot::Signal<int> sig;
+    auto p1 = std::make_shared<s>();
+    auto p2 = std::make_shared<s>();
+
+    auto bind = sig.Bind(&s::f1, p1);
+    sig.Bind(&s::f1, p2);
+    assert(p1.use_count() == 1);
+    sig(1);
+    assert(sum == 2);
+
+    p1.reset();
+    assert(!bind.IsBinded());
+    sig(1);
+    assert(sum == 3);
+    assert(sig.CountSlot() == 1);
+  }
+
+  // weak pointer
+  {
+    sum = 0;
+    evtsigslot::Signal<int> sig;
+    auto p1 = std::make_shared<s>();
+    std::weak_ptr<s> w1 = p1;
+
+    sig.Bind(&s::f2, w1);
+    sig(1);
+    assert(sum == 1);
+    sig.Unbind(w1);
+    sig(1);
+    assert(sum == 1);
+    assert(sig.CountSlot() == 0);
+  }
+
+  // expired slot doesn't stop the event
+  {
+    sum = 0;
+    evtsigslot::Signal<int> sig;
+    auto p1 = std::make_shared<s>();
+
+    sig.Bind([](evtsigslot::Event<int>& e) { sum += e.Get(); });
+    for (int i = 0; i < 8; ++i) sig.Bind(&s::f1, p1);
+    p1.reset();
+    sig(1);
+    assert(sum == 1);
+    assert(sig.CountSlot() == 1);
+  }
+
+  // object expiring after its slot was dispatched is only removed, not
+  // counted expired again by the clean that removes it
+  {
+    sum = 0;
+    evtsigslot::Signal<int> sig;
+    auto p1 = std::make_shared<s>();
+    auto p2 = std::make_shared<s>();
+
+    sig.Bind([&](int) { p2.reset(); });
+    sig.Bind(&s::f1, p1);
+    sig.Bind(&s::f1, p2);
+    p1.reset();
+    assert(sig.CountSlot() == 2 && sig.CountSlot() == 2);
+    sig(1);
+    assert(sum == 1);
+    auto stats = sig.Stats();
+    assert(stats.slots == 1 && stats.expired == 0);
+    assert(sig.CountSlot() == 1);
+  }
+}
+
+struct observer : evtsigslot::Observer {
+  ~observer() { UnbindAll(); }
+  void f1(int i) { sum += i; }
+  void f2(int i) const { sum += 2 * i; }
+  void drop(int) { UnbindAll(); }
+};
+
+void test_observer() {
+  // destroying observer unbind from every signal
+  {
+    sum = 0;
+    evtsigslot::Signal<int> sig1, sig2;
+    {
+      observer o;
+      sig1.Bind(&observer::f1, &o);
+      sig1.Bind(&observer::f2, &o);
+      sig2.Bind(&observer::f1, &o);
+      assert(o.CountBinding() == 3);
+      sig1(1);
+      sig2(1);
+      assert(sum == 4);
+    }
+    assert(sig1.CountSlot() == 0);
+    assert(sig2.CountSlot() == 0);
+    sig1(1);
+    sig2(1);
+    assert(sum == 4);
+  }
+
+  // signal destroyed first
+  {
+    sum = 0;
+    observer o;
+    {
+      evtsigslot::Signal<int> sig;
+      sig.Bind(&observer::f1, &o);
+      sig(1);
+    }
+    assert(sum == 1);
+    assert(o.CountBinding() == 0);
+  }
+
+  // unbinding slot unlink it from observer
+  {
+    sum = 0;
+    observer o;
+    evtsigslot::Signal<int> sig;
+    auto bind = sig.Bind(&observer::f1, &o);
+    sig.Bind(&observer::f2, &o);
+    bind.Unbind();
+    assert(o.CountBinding() == 1);
+    sig.Unbind(&o);
+    assert(o.CountBinding() == 0);
+  }
+
+  // copy doesn't take the binding
+  {
+    sum = 0;
+    evtsigslot::Signal<int> sig;
+    observer o1;
+    sig.Bind(&observer::f1, &o1);
+    observer o2 = o1;
+    assert(o2.CountBinding() == 0);
+    o1.UnbindAll();
+    sig(1);
+    assert(sum == 0);
+  }
+
+  // observer unbinding itself from its own slot doesn't wait for the call
+  {
+    sum = 0;
+    evtsigslot::Signal<int> sig;
+    observer o;
+    sig.Bind(&observer::f1, &o);
+    sig.Bind(&observer::drop, &o);
+    sig.Bind(&observer::f2, &o);
+    sig(1);
+    sig(1);
+    assert(sum == 2 && o.CountBinding() == 0);
+  }
+
+  // signal never emitted again drops its expired slot on a later bind
+  {
+    evtsigslot::Signal<int> sig;
+    {
+      std::vector<observer> os(64);
+      for (auto& o : os) sig.Bind(&observer::f1, &o);
+      assert(sig.Stats().slots == 64);
+    }
+    auto stats = sig.Stats();
+    assert(stats.slots == 0 && stats.expired == 64);
+    sig.Bind(f1);
+    stats = sig.Stats();
+    assert(stats.slots == 1 && stats.expired == 0);
+  }
+}
+
+void test_binding_id() {
+  sum = 0;
+  evtsigslot::Signal<int> sig;
+  s p;
+
+  auto id1 = sig.BindId(f1);
+  auto id2 = sig.BindId(&s::f1, &p);
+  assert(id1.Valid() && id2.Valid() && id1 != id2);
+  assert(sig.IsBinded(id1) && sig.IsBinded(id2));
+  sig(1);
+  assert(sum == 2);
+
+  assert(sig.Block(id1));
+  assert(sig.IsBlocked(id1));
+  sig(1);
+  assert(sum == 3);
+  assert(sig.Unblock(id1));
+  sig(1);
+  assert(sum == 5);
+
+  assert(sig.Unbind(id1));
+  assert(!sig.IsBinded(id1));
+  assert(!sig.Unbind(id1));
+  assert(!sig.Block(id1));
+  assert(sig.CountSlot() == 1);
+  sig(1);
+  assert(sum == 6);
+
+  // reused entry doesn't revive stale id
+  auto id3 = sig.BindId([](int i) { sum += 2 * i; });
+  assert(id3 != id1);
+  assert(!sig.IsBinded(id1) && sig.IsBinded(id3));
+  sig(1);
+  assert(sum == 9);
+
+  sig.Unbind(&s::f1, &p);
+  assert(!sig.IsBinded(id2));
+  sig.UnbindAll();
+  assert(!sig.IsBinded(id3));
+  assert(!sig.IsBinded(evtsigslot::BindingId()));
+}
+
+void test_blocked_mask() {
+  sum = 0;
+  evtsigslot::Signal<int> sig;
+  std::vector<evtsigslot::Binding> bindings;
+  for (int i = 0; i < 130; ++i) bindings.push_back(sig.Bind(f1));
+
+  for (int i = 0; i < 130; ++i)
+    if (i % 64 != 0) bindings[i].Block();
+  sig(1);
+  assert(sum == 3);
+
+  bindings[1].Unblock();
+  bindings[0].Unbind();
+  sig(1);
+  assert(sum == 6);
+
+  // stopping slot still ends the group after rebuild
+  sig.Bind([](evtsigslot::Event<int>& e) { sum += 10 * e.Get(); });
+  sig(1);
+  assert(sum == 16);
+  assert(sig.CountSlot() == 130);
+}
+
+void test_stats() {
+  evtsigslot::EventLoop loop;
+  evtsigslot::Signal<int> sig;
+  s p;
+
+  sig.Bind(f1);
+  sig.Bind(f2);
+  auto id = sig.BindId(&s::f1, &p);
+  assert(sig.Stats().slots == 3);
+  sig.Unbind(id);
+  assert(sig.Stats().slots == 2);
+
+  sig(1);
+  sig(1);
+  auto stats = sig.Stats();
+  assert(stats.emitted == 2 && stats.drained == 2);
+  assert(stats.queued == 0 && stats.high_water == 1);
+  assert(stats.slots == 2 && stats.drainers == 0 && !stats.blocked);
+
+  sig.Attach(loop);
+  for (int i = 0; i < 5; ++i) sig(1);
+  stats = sig.Stats();
+  assert(stats.queued == 5 && stats.high_water == 5);
+  assert(sig.CountQueue() == 5);
+
+  loop.ProcessPending();
+  stats = sig.Stats();
+  assert(stats.emitted == 7 && stats.drained == 7);
+  assert(stats.queued == 0 && stats.high_water == 5);
+
+  sig.Block();
+  sig(1);
+  stats = sig.Stats();
+  assert(stats.blocked && stats.emitted == 7);
+
+  sig.UnbindAll();
+  assert(sig.Stats().slots == 0);
+
+  // list replaced during a dispatch is kept until the dispatch returns
+  sig.Unblock();
+  sig.Detach();
+  evtsigslot::Binding other = sig.Bind(f1);
+  size_t retired = 0;
+  sig.Bind([&] {
+    other.Unbind();
+    retired = sig.Stats().retired;
+  });
+  sig(1);
+  assert(retired == 1 && sig.Stats().retired == 0);
+  assert(!other.Valid());
+}
+
 void test_scoped_connection() {
   sum = 0;
   evtsigslot::Signal<int> sig;
@@ -668,6 +1000,37 @@ void test_signal_moving() {
   auto sig3 = std::move(sig2);
   sig3(1);
   assert(sum == 9);
+
+  // pending timer and rate limit move with the signal
+  using namespace std::chrono_literals;
+  sum = 0;
+  const auto start = evtsigslot::TimerWheel::clock_type::now();
+  evtsigslot::TimerWheel wheel(1ms, start);
+  evtsigslot::Signal<int> timed;
+  timed.Bind(f1);
+  timed.SetMaxDepth(3);
+  timed.QueueAfter(wheel, 5ms, 1);
+  timed.Throttle(wheel, 10ms);
+  timed(10);
+  timed(100);
+  assert(sum == 10);
+
+  auto moved = std::move(timed);
+  assert(moved.MaxDepth() == 3);
+  wheel.Advance(start + 5ms);
+  assert(sum == 11);
+  wheel.Advance(start + 10ms);
+  assert(sum == 111);
+
+  // counters follow the slot they describe
+  evtsigslot::Signal<int> counted, other;
+  counted.Bind(f1);
+  counted(1);
+  counted.Unbind(counted.BindId(f2));
+  other = std::move(counted);
+  assert(other.Stats().slots == 1 && other.Stats().expired == 1);
+  assert(other.Stats().deepest == 1);
+  assert(counted.Stats().expired == 0 && counted.Stats().deepest == 0);
 }
 
 template <typename T>
@@ -704,6 +1067,534 @@ void test_loop() {
   assert(i2.val() == 1);
 }
 
+void test_event_loop() {
+  sum = 0;
+  evtsigslot::Signal<int> sig;
+  evtsigslot::EventLoop loop;
+
+  sig.Bind(f1);
+  sig.Attach(loop);
+
+  sig(1);
+  sig(2);
+  assert(sum == 0);
+  assert(sig.CountQueue() == 2);
+
+  // both event drained in one wakeup
+  assert(loop.ProcessPending() == 1);
+  assert(sum == 3);
+  assert(loop.ProcessPending() == 0);
+
+  sig(1);
+  sig.Detach();
+  assert(sum == 4);
+
+  sig(1);
+  assert(sum == 5);
+  assert(loop.ProcessPending() == 0);
+
+  // queued event is dropped with the signal
+  {
+    evtsigslot::Signal<int> dropped;
+    dropped.Bind(f1);
+    dropped.Attach(loop);
+    dropped(1);
+  }
+  assert(loop.ProcessPending() == 0);
+  assert(sum == 5);
+
+  // slot drained by the loop destroys its signal, the list it replaced
+  // first is still read by the drain
+  auto owned = std::make_unique<evtsigslot::Signal<int>>();
+  owned->Bind(f1);
+  owned->Bind([&](int) {
+    owned->UnbindAll();
+    owned.reset();
+  });
+  owned->Attach(loop);
+  (*owned)(1);
+  (*owned)(2);
+  assert(loop.ProcessPending() == 1);
+  assert(!owned);
+  assert(sum == 5);
+}
+
+void test_queue_after() {
+  using namespace std::chrono_literals;
+  sum = 0;
+  const auto start = evtsigslot::TimerWheel::clock_type::now();
+  evtsigslot::TimerWheel wheel(1ms, start);
+  evtsigslot::Signal<int> sig;
+  sig.Bind(f1);
+
+  sig.QueueAfter(wheel, 5ms, 1);
+  auto cancelled = sig.QueueAfter(wheel, 5ms, 10);
+  // far enough to be cascaded from the third level
+  sig.QueueAfter(wheel, 5000ms, 100);
+  assert(wheel.Count() == 3);
+
+  assert(cancelled.IsPending());
+  assert(cancelled.Cancel());
+  assert(!cancelled.IsPending());
+  assert(!cancelled.Cancel());
+
+  wheel.Advance(start + 4ms);
+  assert(sum == 0);
+  assert(wheel.Advance(start + 5ms) == 1);
+  assert(sum == 1);
+
+  wheel.Advance(start + 4999ms);
+  assert(sum == 1);
+  wheel.Advance(start + 5000ms);
+  assert(sum == 101);
+  assert(wheel.Count() == 0);
+
+  // slot delivered by the wheel moves, then destroys its signal
+  evtsigslot::Signal<int> moved;
+  auto owned = std::make_unique<evtsigslot::Signal<int>>();
+  owned->Bind([&](int i) {
+    sum += i;
+    moved = std::move(*owned);
+    owned.reset();
+  });
+  owned->QueueAfter(wheel, 1ms, 1000);
+  wheel.Advance(start + 5001ms);
+  assert(!owned);
+  assert(sum == 1101);
+  assert(moved.CountSlot() == 1);
+}
+
+void test_queue_every() {
+  using namespace std::chrono_literals;
+  sum = 0;
+  const auto start = evtsigslot::TimerWheel::clock_type::now();
+  evtsigslot::TimerWheel wheel(1ms, start);
+  evtsigslot::Signal<int> sig;
+  sig.Bind(f1);
+
+  auto timer = sig.QueueEvery(wheel, 10ms, 1);
+  for (int i = 1; i <= 35; ++i) wheel.Advance(start + i * 1ms);
+  assert(sum == 3);
+
+  timer.Cancel();
+  for (int i = 36; i <= 100; ++i) wheel.Advance(start + i * 1ms);
+  assert(sum == 3);
+  assert(wheel.Count() == 0);
+
+  // timer is dropped when signal is destroyed first
+  {
+    evtsigslot::Signal<int> tmp;
+    tmp.Bind(f1);
+    tmp.QueueAfter(wheel, 1ms, 1);
+  }
+  wheel.Advance(start + 101ms);
+  assert(sum == 3);
+}
+
+void test_throttle() {
+  using namespace std::chrono_literals;
+  sum = 0;
+  evtsigslot::Signal<int> sig;
+  sig.Bind(f1);
+
+  sig.Throttle(1h);
+  sig(1);
+  sig(2);
+  sig(3);
+  assert(sum == 1);
+  assert(sig.CountQueue() == 0);
+
+  sig.ResetRateLimit();
+  sig(1);
+  assert(sum == 2);
+
+  // trailing value is delivered at the end of the interval
+  sum = 0;
+  const auto start = evtsigslot::TimerWheel::clock_type::now();
+  evtsigslot::TimerWheel wheel(1ms, start);
+  sig.Throttle(wheel, 10ms);
+
+  sig(1);
+  sig(2);
+  sig(3);
+  assert(sum == 1);
+
+  wheel.Advance(start + 9ms);
+  assert(sum == 1);
+  wheel.Advance(start + 10ms);
+  assert(sum == 4);
+
+  sig(4);
+  assert(sum == 4);
+  wheel.Advance(start + 20ms);
+  assert(sum == 8);
+
+  wheel.Advance(start + 31ms);
+  sig(5);
+  assert(sum == 13);
+}
+
+void test_debounce() {
+  using namespace std::chrono_literals;
+  sum = 0;
+  const auto start = evtsigslot::TimerWheel::clock_type::now();
+  evtsigslot::TimerWheel wheel(1ms, start);
+  evtsigslot::Signal<int> sig;
+  sig.Bind(f1);
+  sig.Debounce(wheel, 10ms);
+
+  sig(1);
+  wheel.Advance(start + 5ms);
+  sig(2);
+  wheel.Advance(start + 10ms);
+  assert(sum == 0);
+
+  wheel.Advance(start + 14ms);
+  assert(sum == 0);
+  wheel.Advance(start + 15ms);
+  assert(sum == 2);
+
+  wheel.Advance(start + 100ms);
+  assert(sum == 2);
+
+  // debounced slot destroys its signal
+  auto owned = std::make_unique<evtsigslot::Signal<int>>();
+  owned->Bind([&](int i) {
+    sum += i;
+    owned.reset();
+  });
+  owned->Debounce(wheel, 10ms);
+  (*owned)(3);
+  wheel.Advance(start + 109ms);
+  assert(sum == 2);
+  wheel.Advance(start + 110ms);
+  assert(!owned);
+  assert(sum == 5);
+}
+
+void test_forward() {
+  sum = 0;
+  evtsigslot::Signal<int> sig1, sig2, sig3;
+
+  sig1.Forward(sig2);
+  sig2.Forward(sig3);
+  sig3.Bind(f1);
+  sig2.Bind([](int &i) { i += 1; });
+
+  sig1(1);
+  assert(sum == 2);
+  assert(sig2.CountQueue() == 0);
+
+  // upstream slot after forward is still called
+  sig1.Bind(f1);
+  sig1(1);
+  assert(sum == 5);
+
+  sig2.Block();
+  sig1(1);
+  assert(sum == 6);
+  sig2.Unblock();
+
+  assert(sig1.Unbind(&sig2) == 1);
+  sig1(1);
+  assert(sum == 7);
+}
+
+void test_pipeline() {
+  sum = 0;
+  evtsigslot::Signal<int> sig;
+  std::string str;
+
+  auto even = sig.Filter([](int i) { return i % 2 == 0; });
+  even.Map([](int i) { return i * 10; }).Bind([](int i) { sum += i; });
+  even.Map([](int i) { return std::to_string(i); })
+      .Filter([](const std::string &s) { return s != "2"; })
+      .Bind([&](std::string &s) { str += s; });
+
+  for (int i = 1; i <= 4; ++i) sig(i);
+
+  // 4 is handled by the newer pipeline and never reaches the older one
+  assert(sum == 20);
+  assert(str == "4");
+
+  // rejected event goes on to older slot, passing event ends the group
+  sum = 0;
+  str.clear();
+  int count = 0, reached = 0;
+  evtsigslot::Signal<int> routed;
+  routed.Bind([&](int) { ++reached; });
+  routed.Filter([](int i) { return i % 2 == 0; }).Bind([](int i) {
+    sum += i;
+  });
+  routed.Map([](int i) { return std::to_string(i); })
+      .Filter([](const std::string &s) { return s == "1"; })
+      .Bind([&](std::string &s) { str += s; });
+  routed.Filter([](int i) { return i > 3; }).Bind([&] { ++count; });
+
+  for (int i = 1; i <= 4; ++i) routed(i);
+
+  assert(count == 1);
+  assert(str == "1");
+  assert(sum == 2);
+  assert(reached == 1);
+}
+
+void test_keyed_signal() {
+  sum = 0;
+  evtsigslot::KeyedSignal<std::string, int> sig;
+  s p;
+
+  sig.Bind("a", f1);
+  sig.Bind("a", &s::f1, &p);
+  auto b = sig.Bind("b", f2);
+  assert(sig.CountKey() == 2);
+  assert(sig.CountSlot("a") == 2);
+  assert(sig.CountSlot() == 3);
+
+  sig("a", 1);
+  assert(sum == 2);
+  sig("b", 1);
+  assert(sum == 4);
+  sig("c", 1);
+  assert(sum == 4);
+  assert(sig.CountKey() == 2);
+
+  b.Unbind();
+  sig("b", 1);
+  assert(sum == 4);
+
+  assert(sig.Unbind("a", &p) == 1);
+  sig("a", 1);
+  assert(sum == 5);
+
+  assert(sig.Unbind("a") == 1);
+  sig("a", 1);
+  assert(sum == 5);
+  assert(sig.CountSlot() == 0);
+  assert(sig.CountKey() == 0);
+
+  // transient key is erased once its last slot goes away
+  {
+    evtsigslot::KeyedSignal<int, int> topics;
+    std::vector<evtsigslot::Binding> bindings;
+    for (int i = 0; i < 100; ++i) bindings.push_back(topics.Bind(i, f1));
+    auto shared = std::make_shared<s>();
+    topics.Bind(100, &s::f1, shared);
+    auto o = std::make_unique<observer>();
+    topics.Bind(101, &observer::f1, o.get());
+    // slot unbinding its own key while it is dispatched
+    evtsigslot::Binding self;
+    self = topics.Bind(102, [&](int) { self.Unbind(); });
+    assert(topics.CountKey() == 103);
+
+    for (auto &it : bindings) it.Unbind();
+    shared.reset();
+    o.reset();
+    topics(102, 1);
+    assert(topics.CountKey() == 1);
+    topics(100, 1);
+    assert(topics.CountKey() == 0);
+  }
+}
+
+void test_routed_signal() {
+  struct Log {
+    int severity;
+    int category;
+  };
+
+  int warn = 0, net = 0, fatal_or_net = 0, mid = 0;
+  evtsigslot::RoutedSignal<Log, int Log::*> by_severity(&Log::severity);
+  auto by_category = [](const Log &l) { return l.category; };
+  evtsigslot::RoutedSignal<Log, decltype(by_category)> by_cat(by_category);
+
+  by_severity.Bind(evtsigslot::AtLeast(2), [&] { ++warn; });
+  auto b = by_severity.Bind(evtsigslot::Between(1, 3), [&] { ++mid; });
+  by_severity.Bind(evtsigslot::AtLeast(4) | evtsigslot::Below(0),
+                   [&](Log &l) { fatal_or_net += l.severity; });
+
+  by_cat.Bind(evtsigslot::OneOf<int>(0b1010), [&] { ++net; });
+  assert(by_severity.CountSlot() == 3);
+
+  for (int severity = -1; severity <= 5; ++severity) {
+    by_severity(Log{severity, 0});
+    by_cat(Log{0, severity});
+  }
+
+  assert(warn == 4);
+  assert(mid == 2);
+  assert(fatal_or_net == -1 + 4 + 5);
+  assert(net == 2);
+
+  b.Unbind();
+  by_severity(Log{1, 0});
+  assert(mid == 2);
+  assert(by_severity.CountSlot() == 2);
+
+  // removal past half of the index rebuilds it, slot left keeps its cell
+  int low = 0;
+  std::vector<evtsigslot::Binding> lows;
+  for (int i = 0; i < 4; ++i)
+    lows.push_back(by_severity.Bind(evtsigslot::Below(i), [&] { ++low; }));
+  for (int i = 0; i < 3; ++i) {
+    lows[i].Unbind();
+    by_severity(Log{-1, 0});
+  }
+  assert(low == 3 + 2 + 1);
+  assert(by_severity.CountSlot() == 3);
+  warn = 0;
+  by_severity(Log{3, 0});
+  by_severity(Log{2, 0});
+  assert(warn == 2 && low == 7);
+
+  // slot unbinded by callable is gone without waiting for a rebuild, slot
+  // and index come from the resource
+  struct counting_resource : std::pmr::memory_resource {
+    size_t count = 0;
+    void *do_allocate(size_t bytes, size_t align) override {
+      ++count;
+      return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t align) override {
+      std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const memory_resource &o) const noexcept override {
+      return this == &o;
+    }
+  } resource;
+
+  sum = 0;
+  auto identity = [](int i) { return i; };
+  evtsigslot::RoutedSignal<int, decltype(identity)> by_value(identity,
+                                                             &resource);
+  for (int i = 0; i < 3; ++i) by_value.Bind(evtsigslot::AtLeast(i), f1);
+  by_value.Bind(evtsigslot::Any<int>(), [&] { sum += 100; });
+  by_value(1);
+  assert(sum == 102);
+  assert(by_value.Unbind(f1) == 3);
+  assert(by_value.CountSlot() == 1);
+  by_value(1);
+  assert(sum == 202);
+  assert(resource.count > 0);
+}
+
+void test_combiner() {
+  struct handler {
+    std::optional<int> on(int v) {
+      return v > 10 ? std::optional(v) : std::nullopt;
+    }
+  };
+
+  evtsigslot::Signal<int, std::optional<int>> sig;
+  int calls = 0;
+  handler h;
+
+  // called last
+  sig.Bind([&](int v) -> std::optional<int> {
+    ++calls;
+    return v;
+  });
+  sig.Bind(&handler::on, &h);
+  auto blocked = sig.Bind([&] { return std::optional(-1); });
+  blocked.Block();
+
+  auto first = sig.Emit(evtsigslot::FirstNonEmpty<std::optional<int>>{}, 20);
+  assert(first.value == 20 && calls == 0);
+  first = sig.Emit(evtsigslot::FirstNonEmpty<std::optional<int>>{}, 5);
+  assert(first.value == 5 && calls == 1);
+
+  // queued event still calls every slot
+  sig(1);
+  assert(calls == 2);
+
+  evtsigslot::Signal<int, bool> vote;
+  int voters = 0;
+  for (int i = 0; i < 4; ++i)
+    vote.Bind([&, i](evtsigslot::Event<int>& event) {
+      ++voters;
+      return event.Get() > i;
+    });
+
+  // newest slot asks for more than 3
+  assert(!vote.Emit(evtsigslot::AnyOf{}, 0).value && voters == 4);
+  assert(vote.Emit(evtsigslot::AnyOf{}, 3).value && voters == 6);
+  assert(!vote.Emit(evtsigslot::AllOf{}, 3).value && voters == 7);
+
+  evtsigslot::Signal<void, int> count;
+  for (int i = 1; i <= 4; ++i) count.Bind([i] { return i; });
+  assert(count.Emit(evtsigslot::Sum<int>{}).value == 10);
+
+  auto fit = count.Emit(evtsigslot::Collect<int, 4>{});
+  assert(fit.size == 4 && fit.spill.empty() && fit[0] == 4 && fit[3] == 1);
+
+  // result past the capacity spill to the heap, dispatch goes on
+  auto all = count.Emit(evtsigslot::Collect<int, 3>{});
+  assert(all.size == 4 && all.end() - all.begin() == 4);
+  assert(all[0] == 4 && all[1] == 3 && all[2] == 2 && all[3] == 1);
+
+  count.Block();
+  assert(count.Emit(evtsigslot::Sum<int>{}).value == 0);
+}
+
+void test_veto() {
+  evtsigslot::Signal<int> sig;
+  std::vector<int> calls;
+
+  // group is dispatched in the order its first slot was binded
+  sig.BindGroup(0, [&](int) { calls.push_back(0); });
+  sig.BindGroup(1, [&](int) { calls.push_back(10); });
+  sig.BindGroup(0, [&](evtsigslot::Event<int>& event) {
+    calls.push_back(1);
+    if (event.Get() > 0) event.Veto();
+    event.Skip();
+  });
+
+  // a slot that doesn't skip only ends group 0
+  sig(0);
+  assert((calls == std::vector<int>{1, 0, 10}));
+
+  // veto ends group 1 too, even when the slot skips
+  calls.clear();
+  sig(1);
+  assert((calls == std::vector<int>{1}));
+
+  evtsigslot::Event<int> event(0);
+  assert(event.IsAllowed());
+  event.Veto();
+  assert(!event.IsAllowed());
+  calls.clear();
+  sig.PostEvent(event);
+  assert(calls.empty());
+
+  evtsigslot::Signal<void, int> count;
+  count.Bind([] { return 1; });
+  count.Bind([](evtsigslot::Event<void>& event) {
+    event.Veto();
+    return 2;
+  });
+  assert(count.Emit(evtsigslot::Sum<int>{}).value == 2);
+
+  evtsigslot::Signal<int> order;
+  calls.clear();
+  order.BindGroup(2, [&](int) { calls.push_back(2); });
+  order.BindGroup(1, [&](int) { calls.push_back(1); });
+  order(0);
+  assert((calls == std::vector<int>{2, 1}));
+
+  // veto downstream ends only the downstream dispatch
+  evtsigslot::Signal<int> upstream, downstream;
+  calls.clear();
+  upstream.Forward(downstream);
+  upstream.BindGroup(1, [&](int) { calls.push_back(1); });
+  downstream.Bind([&](int) { calls.push_back(-1); });
+  downstream.Bind([&](evtsigslot::Event<int>& event) {
+    calls.push_back(-2);
+    event.Veto();
+  });
+  upstream(0);
+  assert((calls == std::vector<int>{-2, 1}));
+}
+
 int main() {
   test_free_connection();
   test_static_connection();
@@ -720,6 +1611,11 @@ int main() {
   test_disconnection_by_callable();
   test_disconnection_by_object();
   test_disconnection_by_object_and_pmf();
+  test_tracked_lifetime();
+  test_observer();
+  test_binding_id();
+  test_blocked_mask();
+  test_stats();
   test_scoped_connection();
   test_connection_blocker();
   test_connection_blocking();
@@ -729,6 +1625,18 @@ int main() {
   test_scoped_connection_moving();
   test_signal_moving();
   test_loop();
+  test_reentrancy();
   test_slot_count();
+  test_event_loop();
+  test_queue_after();
+  test_queue_every();
+  test_throttle();
+  test_debounce();
+  test_forward();
+  test_pipeline();
+  test_keyed_signal();
+  test_routed_signal();
+  test_combiner();
+  test_veto();
   return 0;
 }
@@ -3,7 +3,14 @@
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <memory>
 #include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#endif
 
 static std::atomic<std::int64_t> sum{0};
 
@@ -144,11 +151,381 @@ static void test_threaded_misc() {
   }
 }
 
+// test slot binded to an EventLoop is only called on the loop thread
+static void test_threaded_affinity() {
+  sum = 0;
+  evtsigslot::Signal<int> sig;
+  evtsigslot::EventLoop loop;
+  std::atomic<bool> running{false};
+
+  std::thread t([&] { loop.Run(); });
+  loop.Post([&] { running = true; });
+  while (!running) std::this_thread::yield();
+
+  sig.Bind(loop, [&](int i) {
+    assert(loop.IsInLoopThread());
+    sum += i;
+  });
+  sig.Bind(f);
+
+  std::array<std::thread, 10> threads;
+  for (auto &t : threads) t = std::thread(emit_many, std::ref(sig));
+  for (auto &t : threads) t.join();
+
+  loop.Stop();
+  t.join();
+
+  assert(sum == 200000l);
+}
+
+// loop slot is delivered only when the dispatch reaches it, and what it
+// does on the loop thread stops nothing
+static void test_threaded_affinity_order() {
+  evtsigslot::Signal<int> sig;
+  evtsigslot::EventLoop loop;
+  std::vector<int> called;
+
+  sig.Bind(loop, [&](int) { called.push_back(1); });
+  sig.Bind([](evtsigslot::Event<int> &e) { e.Veto(); });
+  sig.Bind(loop, [&](int) { called.push_back(3); });
+  sig.Bind(loop, [&](evtsigslot::Event<int> &e) {
+    called.push_back(4);
+    e.Veto();
+  });
+
+  std::thread([&] { sig(1); }).join();
+  assert(called.empty());
+  loop.ProcessPending();
+  assert((called == std::vector<int>{4, 3}));
+}
+
+// test attached signal is drained by the loop thread
+static void test_threaded_event_loop() {
+  sum = 0;
+  evtsigslot::Signal<int> sig;
+  evtsigslot::EventLoop loop;
+  std::atomic<bool> running{false};
+
+  std::thread t([&] { loop.Run(); });
+  loop.Post([&] { running = true; });
+  while (!running) std::this_thread::yield();
+
+  sig.Bind([&](int i) {
+    assert(loop.IsInLoopThread());
+    sum += i;
+  });
+  sig.Attach(loop);
+
+  std::array<std::thread, 10> threads;
+  for (auto &t : threads) t = std::thread(emit_many, std::ref(sig));
+  for (auto &t : threads) t.join();
+
+  loop.Stop();
+  t.join();
+
+  assert(sum == 100000l);
+}
+
+static void test_threaded_drainers() {
+  sum = 0;
+  evtsigslot::Signal<int> sig;
+  sig.SetDrainers(4);
+  sig.Bind(f);
+
+  std::array<std::thread, 8> threads;
+  for (auto &t : threads) t = std::thread(emit_many, std::ref(sig));
+  for (auto &t : threads) t.join();
+
+  auto stats = sig.Stats();
+  assert(sum == 80000);
+  assert(stats.queued == 0 && stats.drainers == 0);
+}
+
+static void test_threaded_sequencer() {
+  constexpr int producers = 4, count = 20000;
+  evtsigslot::Signal<std::pair<int, int>> sig;
+  sig.SetDrainers(4);
+  sig.SetSequencer(&std::pair<int, int>::first);
+
+  // each entry is only touched by the drainer owning its key
+  std::array<int, producers> last;
+  last.fill(-1);
+  sig.Bind([&](const std::pair<int, int> &val) {
+    assert(last[val.first] + 1 == val.second);
+    last[val.first] = val.second;
+  });
+
+  std::array<std::thread, producers> threads;
+  for (int p = 0; p < producers; ++p)
+    threads[p] = std::thread([&, p] {
+      for (int i = 0; i < count; ++i) sig(p, i);
+    });
+  for (auto &t : threads) t.join();
+
+  for (auto val : last) assert(val == count - 1);
+  assert(sig.Stats().drainers == 0);
+}
+
+static void test_threaded_shards() {
+  constexpr int producers = 6, count = 20000;
+  evtsigslot::Signal<std::pair<int, int>> sig;
+  evtsigslot::EventLoop loop;
+  std::atomic<bool> running{false};
+
+  assert(sig.SetShards(4, evtsigslot::ShardOrder::kProducer));
+  assert(!sig.SetShards(2));
+
+  std::thread t([&] { loop.Run(); });
+  loop.Post([&] { running = true; });
+  while (!running) std::this_thread::yield();
+
+  // only the loop thread touch last
+  std::array<int, producers> last;
+  last.fill(-1);
+  sig.Bind([&](const std::pair<int, int> &val) {
+    assert(loop.IsInLoopThread());
+    assert(last[val.first] + 1 == val.second);
+    last[val.first] = val.second;
+  });
+  sig.Attach(loop);
+
+  std::array<std::thread, producers> threads;
+  for (int p = 0; p < producers; ++p)
+    threads[p] = std::thread([&, p] {
+      for (int i = 0; i < count; ++i) sig(p, i);
+    });
+  for (auto &t : threads) t.join();
+
+  loop.Stop();
+  t.join();
+  sig.Detach();
+
+  for (auto val : last) assert(val == count - 1);
+  auto stats = sig.Stats();
+  assert(stats.emitted == uint64_t(producers) * count);
+  assert(stats.queued == 0);
+
+  // event of thread mapped to different shard keeps emission order
+  evtsigslot::Signal<int> ordered;
+  ordered.SetShards(3);
+  ordered.Attach(loop);
+
+  std::vector<int> order;
+  ordered.Bind([&](int i) { order.push_back(i); });
+  for (int i = 0; i < 8; ++i) std::thread([&, i] { ordered(i); }).join();
+  loop.ProcessPending();
+
+  assert(order == std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+// emitter stalled inside a slot neither blocks binding nor keeps every
+// replaced list alive
+static void test_threaded_stalled_emitter() {
+  evtsigslot::Signal<int> sig;
+  std::atomic<bool> entered{false}, release{false};
+
+  sig.Bind([&](int) {
+    entered = true;
+    while (!release) std::this_thread::yield();
+  });
+
+  std::thread emitter([&] { sig(1); });
+  while (!entered) std::this_thread::yield();
+
+  for (int i = 0; i < 1000; ++i) {
+    auto bind = sig.Bind(f);
+    bind.Unbind();
+    assert(sig.Stats().retired <= 1);
+  }
+  assert(sig.CountSlot() == 1);
+
+  release = true;
+  emitter.join();
+  assert(sig.Stats().retired == 0);
+}
+
+// list unlinked by another thread's collection is still being reclaimed when
+// its signal is destroyed
+static void test_threaded_retire_destroy() {
+  std::atomic<bool> run{true};
+  evtsigslot::Signal<int> noise;
+  std::thread collector([&] {
+    while (run) noise.Bind(f).Unbind();
+  });
+
+  for (int i = 0; i < 2000; ++i) {
+    auto sig = std::make_unique<evtsigslot::Signal<int>>();
+    sig->Bind(f);
+    std::thread emitter([&] {
+      for (int j = 0; j < 10; ++j) (*sig)(1);
+    });
+    for (int j = 0; j < 10; ++j) sig->Bind(f).Unbind();
+    emitter.join();
+    sig.reset();
+  }
+
+  run = false;
+  collector.join();
+}
+
+struct member_observer : evtsigslot::Observer {
+  // member is destroyed before ~Observer, so unbind first
+  ~member_observer() { UnbindAll(); }
+  void on(int i) { sum += values.at(0) * i; }
+
+  std::vector<int> values{1};
+};
+
+// observer destroyed while its signal is emitted on another thread
+static void test_threaded_observer() {
+  sum = 0;
+  evtsigslot::Signal<int> sig;
+  std::atomic<bool> run{true};
+  std::thread emitter([&] {
+    while (run) sig(1);
+  });
+
+  for (int i = 0; i < 20000; ++i) {
+    member_observer o;
+    sig.Bind(&member_observer::on, &o);
+    std::this_thread::yield();
+  }
+
+  run = false;
+  emitter.join();
+  assert(sig.CountSlot() == 0);
+}
+
+// wheel advanced on another thread never delivers to a signal being
+// destroyed
+static void test_threaded_timer_destroy() {
+  using namespace std::chrono_literals;
+  evtsigslot::TimerWheel wheel(1ms);
+  std::atomic<bool> run{true};
+  std::thread ticker([&] {
+    while (run) wheel.Advance();
+  });
+
+  for (int i = 0; i < 2000; ++i) {
+    auto sig = std::make_unique<evtsigslot::Signal<int>>();
+    sig->Bind(f);
+    sig->Throttle(wheel, 1ms);
+    for (int j = 0; j < 3; ++j) {
+      (*sig)(1);
+      sig->QueueAfter(wheel, 1ms, 1);
+    }
+    if (i % 2) std::this_thread::sleep_for(1ms);
+    sig.reset();
+  }
+
+  run = false;
+  ticker.join();
+}
+
+// signal destroyed while the loop thread drains it, no slot runs once the
+// destructor returns
+static void test_threaded_loop_destroy() {
+  evtsigslot::EventLoop loop;
+  std::atomic<bool> running{false}, destroyed{false};
+  std::thread t([&] { loop.Run(); });
+  loop.Post([&] { running = true; });
+  while (!running) std::this_thread::yield();
+
+  for (int i = 0; i < 2000; ++i) {
+    destroyed = false;
+    auto sig = std::make_unique<evtsigslot::Signal<int>>();
+    sig->Bind([&](int v) {
+      assert(!destroyed);
+      sum += v;
+    });
+    sig->Attach(loop);
+    for (int j = 0; j < 10; ++j) (*sig)(1);
+    if (i % 2) std::this_thread::yield();
+    sig.reset();
+    destroyed = true;
+  }
+
+  loop.Stop();
+  t.join();
+}
+
+// id unbinded and its entry reused by another slot while a thread still
+// blocks and unbinds through the old id
+static void test_threaded_binding_id_reuse() {
+  evtsigslot::Signal<int> sig;
+  std::atomic<evtsigslot::BindingId> victim{evtsigslot::BindingId()};
+  std::atomic<bool> run{true};
+  std::thread stale([&] {
+    while (run) {
+      auto id = victim.load();
+      sig.Block(id);
+      sig.Unbind(id);
+    }
+  });
+
+  int hits = 0;
+  for (int i = 0; i < 100000; ++i) {
+    auto id = sig.BindId([](int) {});
+    victim = id;
+    sig.Unbind(id);
+
+    // takes the entry the victim just released
+    auto probe = sig.BindId([&](int) { ++hits; });
+    sig(1);
+    assert(hits == i + 1);
+    assert(sig.IsBinded(probe) && !sig.IsBlocked(probe));
+    sig.Unbind(probe);
+  }
+
+  run = false;
+  stale.join();
+}
+
+#ifdef EVTSIGSLOT_HAS_EVENTFD
+// pending work always leaves the fd readable, whatever the interleaving of
+// producer and ProcessPending
+static void test_threaded_eventfd() {
+  constexpr int producers = 4;
+  constexpr int tasks = 20000;
+
+  evtsigslot::EventLoop loop;
+  std::atomic<int> run{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < producers; ++i)
+    threads.emplace_back([&] {
+      for (int j = 0; j < tasks; ++j) loop.Post([&] { ++run; });
+    });
+
+  pollfd fd{loop.Fd(), POLLIN, 0};
+  while (run < producers * tasks) {
+    assert(poll(&fd, 1, 1000) == 1);
+    loop.ProcessPending();
+  }
+
+  for (auto& thread : threads) thread.join();
+}
+#endif
+
 int main() {
   test_threaded_emission();
   test_threaded_mix();
   test_threaded_crossed();
   test_threaded_misc();
+  test_threaded_affinity();
+  test_threaded_affinity_order();
+  test_threaded_event_loop();
+  test_threaded_timer_destroy();
+  test_threaded_loop_destroy();
+#ifdef EVTSIGSLOT_HAS_EVENTFD
+  test_threaded_eventfd();
+#endif
+  test_threaded_drainers();
+  test_threaded_sequencer();
+  test_threaded_shards();
+  test_threaded_stalled_emitter();
+  test_threaded_retire_destroy();
+  test_threaded_observer();
+  test_threaded_binding_id_reuse();
 
   return 0;
 }
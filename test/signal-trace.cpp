@@ -0,0 +1,90 @@
+#include <evtsigslot/signal.h>
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+static int sum = 0;
+
+static size_t count(const std::string& text, const std::string& what) {
+  size_t ret = 0;
+  for (auto pos = text.find(what); pos != std::string::npos;
+       pos = text.find(what, pos + 1))
+    ++ret;
+  return ret;
+}
+
+static std::string read(const std::string& path) {
+  std::ifstream file(path);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+
+void test_trace() {
+  auto& tracer = evtsigslot::trace::Tracer::Instance();
+  tracer.Clear();
+
+  evtsigslot::EventLoop loop;
+  evtsigslot::Signal<int> sig;
+  tracer.Name(&sig, "clicked");
+
+  auto bind = sig.Bind([](int i) { sum += i; });
+  tracer.Name(bind, "on \"click\"");
+  sig.Bind([](int i) { sum += i; });
+
+  sig(1);
+  assert(sum == 2);
+
+  // queued on another thread, drained on this one
+  sig.Attach(loop);
+  std::thread([&] {
+    sig(1);
+    sig(1);
+  }).join();
+  loop.ProcessPending();
+  assert(sum == 6);
+
+  const std::string path = "evtsigslot-trace.json";
+  assert(tracer.Flush(path));
+  const auto text = read(path);
+  std::remove(path.c_str());
+
+  assert(text.rfind("{\"traceEvents\":[", 0) == 0);
+  assert(count(text, "\"name\":\"queue clicked\"") == 3);
+  assert(count(text, "\"cat\":\"queue-wait\",\"ph\":\"b\"") == 3);
+  assert(count(text, "\"cat\":\"queue-wait\",\"ph\":\"e\"") == 3);
+  assert(count(text, "\"name\":\"drain clicked\"") == 2);
+  assert(count(text, "\"name\":\"on \\\"click\\\"\",\"cat\":\"slot\"") == 3);
+  assert(count(text, "\"cat\":\"slot\"") == 6);
+  assert(count(text, "\"thread_name\"") == 2);
+  assert(count(text, "{") == count(text, "}"));
+  assert(tracer.Dropped() == 0);
+}
+
+void test_trace_disabled() {
+  auto& tracer = evtsigslot::trace::Tracer::Instance();
+  tracer.Clear();
+  tracer.SetEnabled(false);
+
+  evtsigslot::Signal<int> sig;
+  sig.Bind([](int i) { sum += i; });
+  sig(1);
+
+  const std::string path = "evtsigslot-trace.json";
+  assert(tracer.Flush(path));
+  const auto text = read(path);
+  std::remove(path.c_str());
+
+  assert(count(text, "\"cat\"") == 0);
+  tracer.SetEnabled(true);
+}
+
+int main() {
+  test_trace();
+  test_trace_disabled();
+  return 0;
+}